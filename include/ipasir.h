@@ -0,0 +1,103 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+#ifndef IPASIR_H
+#define IPASIR_H
+
+
+#include <stdint.h>
+
+
+/**
+ * Incremental SAT solver interface following IPASIR, the interface of the
+ * incremental track of the SAT competition.
+ *
+ * Literals are non-zero integers, a negative number is the negation of
+ * the Variable with the same absolute number.
+ * A solver keeps its Clauses, learned Clauses and allocations between
+ * calls of ipasir_solve, so closely related queries are cheap.
+**/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * Returns name and version of the solver.
+**/
+const char* ipasir_signature(void);
+
+/**
+ * Creates a new solver without any Clauses.
+**/
+void* ipasir_init(void);
+
+/**
+ * Destroys a solver.
+**/
+void ipasir_release(void* solver);
+
+/**
+ * Adds a Literal to the Clause that is currently being added, 0 ends the
+ * Clause and adds it to the solver.
+**/
+void ipasir_add(void* solver, int32_t lit_or_zero);
+
+/**
+ * Assumes a Literal to be true for the next call of ipasir_solve only.
+**/
+void ipasir_assume(void* solver, int32_t lit);
+
+/**
+ * Solves the Clauses under the assumptions made since the last call.
+ *
+ * Returns 10 if satisfiable, 20 if unsatisfiable and 0 if the search was
+ * terminated.
+**/
+int ipasir_solve(void* solver);
+
+/**
+ * Returns lit if it is true in the model found by the last call of
+ * ipasir_solve, -lit if it is false and 0 if its value does not matter.
+**/
+int32_t ipasir_val(void* solver, int32_t lit);
+
+/**
+ * Returns 1 if the assumption lit was needed to prove the last call of
+ * ipasir_solve unsatisfiable, 0 otherwise.
+**/
+int ipasir_failed(void* solver, int32_t lit);
+
+/**
+ * Sets a callback that is polled while solving, the search stops as soon
+ * as it returns a value other than 0.
+**/
+void ipasir_set_terminate(void* solver, void* data, int (*terminate)(void* data));
+
+/**
+ * Sets a callback that is called with every learned Clause of at most
+ * max_length Literals. The Clause is terminated by 0.
+**/
+void ipasir_set_learn(void* solver, void* data, int max_length, void (*learn)(void* data, int32_t* clause));
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
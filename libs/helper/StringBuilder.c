@@ -52,7 +52,7 @@ char* StringBuilder_destroy_to_string(StringBuilder* builder) {
     char* buf = builder->buf;
 
     // Shrink buffer to minimum size required
-    size_t buf_l = strlen(buf) + 1;
+    size_t buf_l = builder->filled + 1;
     buf = realloc(buf, buf_l);
     assert(buf != NULL);
 
@@ -65,9 +65,11 @@ void StringBuilder_append_string(StringBuilder* builder, char* str) {
     assert(builder != NULL);
     assert(str != NULL);
 
+    const size_t str_len = strlen(str);
+
     // Resize buffer if necessary
     {
-        const size_t required_size = strlen(builder->buf) + strlen(str) + 1;
+        const size_t required_size = builder->filled + str_len + 1;
         if (required_size > builder->size) {
             size_t new_len = builder->size;
             do {
@@ -80,7 +82,8 @@ void StringBuilder_append_string(StringBuilder* builder, char* str) {
     }
 
     // Add string
-    strcat(builder->buf, str);
+    memcpy(builder->buf + builder->filled, str, str_len + 1);
+    builder->filled += str_len;
 }
 
 void StringBuilder_append_char(StringBuilder* builder, char c) {
@@ -88,7 +91,7 @@ void StringBuilder_append_char(StringBuilder* builder, char c) {
 
     // Resize buffer if necessary
     {
-        const size_t required_size = strlen(builder->buf) + 1 + 1;
+        const size_t required_size = builder->filled + 1 + 1;
         if (required_size > builder->size) {
             size_t new_len = builder->size;
             do {
@@ -101,9 +104,8 @@ void StringBuilder_append_char(StringBuilder* builder, char c) {
     }
 
     // Add char
-    size_t len = strlen(builder->buf);
-    builder->buf[len] = c;
-    builder->buf[len + 1] = '\0';
+    builder->buf[builder->filled++] = c;
+    builder->buf[builder->filled] = '\0';
 }
 
 void StringBuilder_append_int(StringBuilder* builder, int integer) {
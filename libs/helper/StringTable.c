@@ -0,0 +1,151 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+
+
+#include "StringTable_private.h"
+
+#include <assert.h>
+#include <string.h>
+
+
+static unsigned int StringTable_hash(const char* str, size_t length) {
+    // FNV-1a
+    unsigned int hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)str[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+static void StringTable_insert_slot(StringTable* table, unsigned int number) {
+    unsigned int mask = table->slots_c - 1;
+    unsigned int slot = table->hashes_v[number] & mask;
+
+    while (table->slots_v[slot] != 0) {
+        slot = (slot + 1) & mask;
+    }
+    table->slots_v[slot] = number + 1;
+}
+
+StringTable* StringTable_create(unsigned int capacity) {
+    if (capacity == 0) {
+        capacity = 1;
+    }
+
+    StringTable* table = malloc(sizeof(StringTable));
+    assert(table != NULL);
+
+    table->strings_v = malloc(capacity * sizeof(char*));
+    table->hashes_v = malloc(capacity * sizeof(unsigned int));
+    assert(table->strings_v != NULL);
+    assert(table->hashes_v != NULL);
+    table->strings_c = 0;
+    table->capacity = capacity;
+
+    // Keep hash table at most half full
+    table->slots_c = 1;
+    while (table->slots_c < 2 * capacity) {
+        table->slots_c *= 2;
+    }
+    table->slots_v = calloc(table->slots_c, sizeof(unsigned int));
+    assert(table->slots_v != NULL);
+
+    return table;
+}
+
+void StringTable_destroy(StringTable* table) {
+    assert(table != NULL);
+
+    for (unsigned int i = 0; i < table->strings_c; i++) {
+        free(table->strings_v[i]);
+    }
+    free(table->strings_v);
+    free(table->hashes_v);
+    free(table->slots_v);
+    free(table);
+}
+
+static bool StringTable_lookup(const StringTable* table, const char* str, size_t length, unsigned int hash,
+                               unsigned int* number) {
+    unsigned int mask = table->slots_c - 1;
+
+    for (unsigned int slot = hash & mask; table->slots_v[slot] != 0; slot = (slot + 1) & mask) {
+        unsigned int candidate = table->slots_v[slot] - 1;
+
+        if (table->hashes_v[candidate] == hash &&
+            strncmp(table->strings_v[candidate], str, length) == 0 &&
+            table->strings_v[candidate][length] == '\0') {
+            *number = candidate;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+unsigned int StringTable_intern(StringTable* table, const char* str, size_t length) {
+    assert(table != NULL);
+    assert(str != NULL || length == 0);
+
+    // Look for string in hash table
+    unsigned int hash = StringTable_hash(str, length);
+    unsigned int number;
+    if (StringTable_lookup(table, str, length, hash, &number)) {
+        return number;
+    }
+
+    // Resize if necessary
+    if (table->strings_c == table->capacity) {
+        table->capacity *= 2;
+        table->strings_v = realloc(table->strings_v, table->capacity * sizeof(char*));
+        table->hashes_v = realloc(table->hashes_v, table->capacity * sizeof(unsigned int));
+        assert(table->strings_v != NULL);
+        assert(table->hashes_v != NULL);
+
+        // Rebuild hash table with twice as many slots
+        free(table->slots_v);
+        table->slots_c *= 2;
+        table->slots_v = calloc(table->slots_c, sizeof(unsigned int));
+        assert(table->slots_v != NULL);
+        for (unsigned int i = 0; i < table->strings_c; i++) {
+            StringTable_insert_slot(table, i);
+        }
+    }
+
+    // Add copy of string
+    number = table->strings_c++;
+    char* copy = malloc(length + 1);
+    assert(copy != NULL);
+    memcpy(copy, str, length);
+    copy[length] = '\0';
+
+    table->strings_v[number] = copy;
+    table->hashes_v[number] = hash;
+    StringTable_insert_slot(table, number);
+
+    return number;
+}
+
+bool StringTable_find(const StringTable* table, const char* str, size_t length, unsigned int* number) {
+    assert(table != NULL);
+    assert(str != NULL || length == 0);
+    assert(number != NULL);
+
+    return StringTable_lookup(table, str, length, StringTable_hash(str, length), number);
+}
@@ -14,13 +14,13 @@
 **/
 
 
-#ifndef LINKEDLIST_PRIV_H
-#define LINKEDLIST_PRIV_H
 
 
-#include "LinkedList.h"
+#ifndef STRINGTABLE_PRIV_H
+#define STRINGTABLE_PRIV_H
 
-#include <stdbool.h>
+
+#include "StringTable.h"
 
 
 #endif
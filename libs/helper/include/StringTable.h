@@ -0,0 +1,57 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+
+
+#ifndef STRINGTABLE_H
+#define STRINGTABLE_H
+
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+
+/**
+ * Interns strings by assigning each distinct string a number.
+ *
+ * Numbers are given out consecutively starting at 0 in order of first
+ * insertion. Strings are looked up in a hash table, so interning takes
+ * expected constant time in the length of the string.
+**/
+typedef struct {
+    // Copies of all strings and their hashes indexed by number
+    char** strings_v;
+    unsigned int* hashes_v;
+    unsigned int strings_c;
+    unsigned int capacity;
+
+    // Open addressing hash table containing number + 1 of every string
+    // (0 marks an empty slot). Number of slots is a power of two.
+    unsigned int* slots_v;
+    unsigned int slots_c;
+} StringTable;
+
+
+StringTable* StringTable_create(unsigned int capacity);
+
+void StringTable_destroy(StringTable* table);
+
+unsigned int StringTable_intern(StringTable* table, const char* str, size_t length);
+
+bool StringTable_find(const StringTable* table, const char* str, size_t length, unsigned int* number);
+
+
+#endif
@@ -0,0 +1,196 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+#include "ActivityHeap.h"
+
+#include <assert.h>
+#include <stdlib.h>
+
+
+static inline void ActivityHeap_sift_up(ActivityHeap* heap, unsigned int pos) {
+    unsigned int index = heap->heap_v[pos];
+    double activity = heap->activities_v[index];
+
+    // Move parents with lower activity down
+    while (pos > 0) {
+        unsigned int parent = (pos - 1) / 2;
+        if (heap->activities_v[heap->heap_v[parent]] >= activity) {
+            break;
+        }
+
+        heap->heap_v[pos] = heap->heap_v[parent];
+        heap->positions_v[heap->heap_v[pos]] = pos;
+        pos = parent;
+    }
+
+    heap->heap_v[pos] = index;
+    heap->positions_v[index] = pos;
+}
+
+static inline void ActivityHeap_sift_down(ActivityHeap* heap, unsigned int pos) {
+    unsigned int index = heap->heap_v[pos];
+    double activity = heap->activities_v[index];
+
+    // Move children with higher activity up
+    while (2 * pos + 1 < heap->heap_c) {
+        unsigned int child = 2 * pos + 1;
+        if (child + 1 < heap->heap_c &&
+            heap->activities_v[heap->heap_v[child + 1]] > heap->activities_v[heap->heap_v[child]]) {
+            child++;
+        }
+
+        if (heap->activities_v[heap->heap_v[child]] <= activity) {
+            break;
+        }
+
+        heap->heap_v[pos] = heap->heap_v[child];
+        heap->positions_v[heap->heap_v[pos]] = pos;
+        pos = child;
+    }
+
+    heap->heap_v[pos] = index;
+    heap->positions_v[index] = pos;
+}
+
+ActivityHeap* ActivityHeap_create(unsigned int capacity) {
+    ActivityHeap* heap = malloc(sizeof(ActivityHeap));
+    assert(heap != NULL);
+
+    heap->heap_v = malloc((capacity + 1) * sizeof(unsigned int));
+    heap->positions_v = malloc((capacity + 1) * sizeof(int));
+    heap->activities_v = malloc((capacity + 1) * sizeof(double));
+    assert(heap->heap_v != NULL);
+    assert(heap->positions_v != NULL);
+    assert(heap->activities_v != NULL);
+    heap->capacity = capacity;
+
+    // All activities are equal so indices are already in heap order
+    for (unsigned int i = 0; i < capacity; i++) {
+        heap->heap_v[i] = i;
+        heap->positions_v[i] = i;
+        heap->activities_v[i] = 0.0;
+    }
+    heap->heap_c = capacity;
+
+    return heap;
+}
+
+void ActivityHeap_destroy(ActivityHeap* heap) {
+    assert(heap != NULL);
+
+    free(heap->heap_v);
+    free(heap->positions_v);
+    free(heap->activities_v);
+    free(heap);
+}
+
+void ActivityHeap_grow(ActivityHeap* heap, unsigned int capacity) {
+    assert(heap != NULL);
+
+    if (capacity <= heap->capacity) {
+        return;
+    }
+
+    heap->heap_v = realloc(heap->heap_v, (capacity + 1) * sizeof(unsigned int));
+    heap->positions_v = realloc(heap->positions_v, (capacity + 1) * sizeof(int));
+    heap->activities_v = realloc(heap->activities_v, (capacity + 1) * sizeof(double));
+    assert(heap->heap_v != NULL);
+    assert(heap->positions_v != NULL);
+    assert(heap->activities_v != NULL);
+
+    unsigned int old_capacity = heap->capacity;
+    heap->capacity = capacity;
+    for (unsigned int i = old_capacity; i < capacity; i++) {
+        heap->positions_v[i] = -1;
+        heap->activities_v[i] = 0.0;
+        ActivityHeap_insert(heap, i);
+    }
+}
+
+bool ActivityHeap_is_empty(ActivityHeap* heap) {
+    assert(heap != NULL);
+
+    return heap->heap_c == 0;
+}
+
+void ActivityHeap_insert(ActivityHeap* heap, unsigned int index) {
+    assert(heap != NULL);
+    assert(index < heap->capacity);
+
+    if (heap->positions_v[index] >= 0) {
+        return;
+    }
+
+    heap->heap_v[heap->heap_c] = index;
+    heap->positions_v[index] = heap->heap_c;
+    heap->heap_c++;
+    ActivityHeap_sift_up(heap, heap->heap_c - 1);
+}
+
+unsigned int ActivityHeap_pop(ActivityHeap* heap) {
+    assert(heap != NULL);
+    assert(heap->heap_c > 0);
+
+    unsigned int top = heap->heap_v[0];
+    heap->positions_v[top] = -1;
+    heap->heap_c--;
+
+    // Move last element to the top and restore heap order
+    if (heap->heap_c > 0) {
+        heap->heap_v[0] = heap->heap_v[heap->heap_c];
+        heap->positions_v[heap->heap_v[0]] = 0;
+        ActivityHeap_sift_down(heap, 0);
+    }
+
+    return top;
+}
+
+double ActivityHeap_bump(ActivityHeap* heap, unsigned int index, double amount) {
+    assert(heap != NULL);
+    assert(index < heap->capacity);
+
+    heap->activities_v[index] += amount;
+    if (heap->positions_v[index] >= 0) {
+        ActivityHeap_sift_up(heap, heap->positions_v[index]);
+    }
+
+    return heap->activities_v[index];
+}
+
+void ActivityHeap_set(ActivityHeap* heap, unsigned int index, double activity) {
+    assert(heap != NULL);
+    assert(index < heap->capacity);
+
+    double previous = heap->activities_v[index];
+    heap->activities_v[index] = activity;
+    if (heap->positions_v[index] < 0) {
+        return;
+    }
+
+    if (activity > previous) {
+        ActivityHeap_sift_up(heap, heap->positions_v[index]);
+    } else {
+        ActivityHeap_sift_down(heap, heap->positions_v[index]);
+    }
+}
+
+void ActivityHeap_rescale(ActivityHeap* heap, double factor) {
+    assert(heap != NULL);
+
+    for (unsigned int i = 0; i < heap->capacity; i++) {
+        heap->activities_v[i] *= factor;
+    }
+}
@@ -0,0 +1,93 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+#ifndef ACTIVITYHEAP_H
+#define ACTIVITYHEAP_H
+
+
+#include <stdbool.h>
+
+
+/**
+ * Binary max-heap of indices (e.g. of Variables) keyed by an
+ * activity value for every index.
+ *
+ * Activities are stored for all indices, whether they are currently
+ * contained in the heap or not.
+**/
+typedef struct {
+    unsigned int* heap_v;
+    unsigned int heap_c;
+
+    // Position of every index in heap_v or -1 if not contained
+    int* positions_v;
+
+    double* activities_v;
+    unsigned int capacity;
+} ActivityHeap;
+
+
+/**
+ * Creates a new ActivityHeap containing all indices from 0 to
+ * capacity - 1, each with activity 0.
+**/
+ActivityHeap* ActivityHeap_create(unsigned int capacity);
+
+/**
+ * Destroys an ActivityHeap.
+**/
+void ActivityHeap_destroy(ActivityHeap* heap);
+
+/**
+ * Adds all indices from the current capacity up to capacity - 1 with
+ * activity 0.
+**/
+void ActivityHeap_grow(ActivityHeap* heap, unsigned int capacity);
+
+bool ActivityHeap_is_empty(ActivityHeap* heap);
+
+/**
+ * Inserts index into heap if it is not contained already.
+**/
+void ActivityHeap_insert(ActivityHeap* heap, unsigned int index);
+
+/**
+ * Removes and returns the index with the highest activity.
+**/
+unsigned int ActivityHeap_pop(ActivityHeap* heap);
+
+/**
+ * Increases the activity of index by amount.
+ *
+ * Returns the new activity.
+**/
+double ActivityHeap_bump(ActivityHeap* heap, unsigned int index, double amount);
+
+/**
+ * Sets the activity of index to the given value, which may be lower
+ * than before.
+**/
+void ActivityHeap_set(ActivityHeap* heap, unsigned int index, double activity);
+
+/**
+ * Multiplies the activity of every index by factor.
+ *
+ * This does not change the order of the heap.
+**/
+void ActivityHeap_rescale(ActivityHeap* heap, double factor);
+
+
+#endif
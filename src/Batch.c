@@ -0,0 +1,377 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+#include "Batch.h"
+#include "InputFile.h"
+
+#include <assert.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+
+/**
+ * A parsed file waiting to be solved, formula is NULL if it could not be
+ * parsed.
+**/
+typedef struct {
+    unsigned int file;
+    Formula* formula;
+    double parse_duration;
+} BatchItem;
+
+/**
+ * State shared by all threads of a batch.
+**/
+typedef struct {
+    const BatchOptions* options;
+
+    char** files_v;
+    unsigned int files_c;
+    unsigned int files_capacity;
+
+    // Index of the next file to parse
+    atomic_uint next_file;
+
+    // Parsed files filled by the parser threads and emptied by the
+    // workers. At most items_capacity Formulas are kept, so memory doesn't
+    // grow with the number of files.
+    BatchItem* items_v;
+    unsigned int items_capacity;
+    unsigned int items_head;
+    unsigned int items_c;
+
+    // Number of files parsed and queued so far
+    unsigned int parsed_c;
+
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+
+    // Whether any file could not be parsed
+    atomic_bool failed;
+} Batch;
+
+
+static void Batch_add_file(Batch* batch, const char* path) {
+    if (batch->files_c == batch->files_capacity) {
+        batch->files_capacity *= 2;
+        batch->files_v = realloc(batch->files_v, batch->files_capacity * sizeof(char*));
+        assert(batch->files_v != NULL);
+    }
+
+    batch->files_v[batch->files_c] = strdup(path);
+    assert(batch->files_v[batch->files_c] != NULL);
+    batch->files_c++;
+}
+
+static int Batch_compare_paths(const void* a, const void* b) {
+    return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+/**
+ * Adds the given file or all files in the given directory (in order of
+ * their names).
+**/
+static void Batch_add_path(Batch* batch, const char* path) {
+    struct stat status;
+    if (stat(path, &status) != 0 || !S_ISDIR(status.st_mode)) {
+        // Errors are reported when the file is opened
+        Batch_add_file(batch, path);
+        return;
+    }
+
+    DIR* directory = opendir(path);
+    if (directory == NULL) {
+        fprintf(stderr, "Could not open directory '%s'\n", path);
+        atomic_store(&batch->failed, true);
+        return;
+    }
+
+    unsigned int first = batch->files_c;
+    struct dirent* entry;
+    while ((entry = readdir(directory)) != NULL) {
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+
+        size_t length = strlen(path) + strlen(entry->d_name) + 2;
+        char* file = malloc(length);
+        assert(file != NULL);
+        snprintf(file, length, "%s/%s", path, entry->d_name);
+
+        if (stat(file, &status) == 0 && S_ISREG(status.st_mode)) {
+            Batch_add_file(batch, file);
+        }
+        free(file);
+    }
+    closedir(directory);
+
+    qsort(batch->files_v + first, batch->files_c - first, sizeof(char*), Batch_compare_paths);
+}
+
+/**
+ * Adds every non-empty line of stdin as a path.
+**/
+static void Batch_add_paths_from_stdin(Batch* batch) {
+    InputFile* input = InputFile_read(stdin);
+
+    const char* line = input->data;
+    const char* end = input->data + input->length;
+    while (line < end) {
+        const char* line_end = memchr(line, '\n', end - line);
+        if (line_end == NULL) {
+            line_end = end;
+        }
+
+        size_t length = line_end - line;
+        if (length > 0 && line[length - 1] == '\r') {
+            length--;
+        }
+        if (length > 0) {
+            char* path = strndup(line, length);
+            assert(path != NULL);
+            Batch_add_path(batch, path);
+            free(path);
+        }
+
+        line = line_end + 1;
+    }
+
+    InputFile_close(input);
+}
+
+/**
+ * Asks the operating system to start reading a file that will be needed
+ * soon.
+**/
+static void Batch_prefetch(const char* path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+
+    #ifdef POSIX_FADV_WILLNEED
+        posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+    #endif
+    close(fd);
+}
+
+static double Batch_get_time(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec * 1000.0 + time.tv_nsec / 1e6;
+}
+
+/**
+ * Parses a single file, returns NULL if this fails.
+**/
+static Formula* Batch_parse_file(Batch* batch, const char* path) {
+    InputFile* input = InputFile_open(path);
+    if (input == NULL) {
+        return NULL;
+    }
+
+    Formula* formula = Parser_parse_formula(input->data, input->length, batch->options->format);
+    InputFile_close(input);
+    return formula;
+}
+
+/**
+ * Parses the next unclaimed file until all files are claimed and queues
+ * them for the workers, waiting while the queue is full. The file that
+ * will be claimed after the ones all parsers are working on is read
+ * ahead.
+**/
+static void* Batch_run_parser(void* data) {
+    Batch* batch = data;
+    unsigned int parsers_c = batch->options->threads_c;
+
+    while (true) {
+        unsigned int index = atomic_fetch_add(&batch->next_file, 1);
+        if (index >= batch->files_c) {
+            break;
+        }
+        if (index + parsers_c < batch->files_c) {
+            Batch_prefetch(batch->files_v[index + parsers_c]);
+        }
+
+        double start = Batch_get_time();
+        BatchItem item;
+        item.file = index;
+        item.formula = Batch_parse_file(batch, batch->files_v[index]);
+        item.parse_duration = Batch_get_time() - start;
+
+        pthread_mutex_lock(&batch->lock);
+        while (batch->items_c == batch->items_capacity) {
+            pthread_cond_wait(&batch->not_full, &batch->lock);
+        }
+        batch->items_v[(batch->items_head + batch->items_c) % batch->items_capacity] = item;
+        batch->items_c++;
+        batch->parsed_c++;
+
+        // After the last file all waiting workers have to notice that no
+        // more files come
+        if (batch->parsed_c == batch->files_c) {
+            pthread_cond_broadcast(&batch->not_empty);
+        } else {
+            pthread_cond_signal(&batch->not_empty);
+        }
+        pthread_mutex_unlock(&batch->lock);
+    }
+
+    return NULL;
+}
+
+/**
+ * Takes the next parsed file from the queue.
+ *
+ * Returns false if all files were taken.
+**/
+static bool Batch_take_item(Batch* batch, BatchItem* item) {
+    pthread_mutex_lock(&batch->lock);
+    while (batch->items_c == 0 && batch->parsed_c < batch->files_c) {
+        pthread_cond_wait(&batch->not_empty, &batch->lock);
+    }
+
+    bool taken = batch->items_c > 0;
+    if (taken) {
+        *item = batch->items_v[batch->items_head];
+        batch->items_head = (batch->items_head + 1) % batch->items_capacity;
+        batch->items_c--;
+        pthread_cond_signal(&batch->not_full);
+    }
+    pthread_mutex_unlock(&batch->lock);
+
+    return taken;
+}
+
+/**
+ * Solves a parsed Formula and returns its result as string.
+**/
+static const char* Batch_solve_formula(Batch* batch, Formula* formula) {
+    const BatchOptions* options = batch->options;
+
+    formula->decision_heuristic = options->decision_heuristic;
+    formula->decision_phase = options->decision_phase;
+    FormulaStatus result = options->engine(formula);
+    Formula_destroy(formula);
+
+    return (result == FormulaStatus_FALSE) ? "UNSATISFIABLE" : "SATISFIABLE";
+}
+
+static void* Batch_run_worker(void* data) {
+    Batch* batch = data;
+
+    BatchItem item;
+    while (Batch_take_item(batch, &item)) {
+        const char* result = "ERROR";
+        double duration = item.parse_duration;
+        if (item.formula == NULL) {
+            atomic_store(&batch->failed, true);
+        } else {
+            double start = Batch_get_time();
+            result = Batch_solve_formula(batch, item.formula);
+            duration += Batch_get_time() - start;
+        }
+
+        // Print every line at once, so that lines of different threads
+        // don't get mixed
+        flockfile(stdout);
+        printf("%s\t%s\t%.3f ms\n", batch->files_v[item.file], result, duration);
+        fflush(stdout);
+        funlockfile(stdout);
+    }
+
+    return NULL;
+}
+
+int Batch_run(char** paths_v, unsigned int paths_c, const BatchOptions* options) {
+    assert(paths_v != NULL || paths_c == 0);
+    assert(options != NULL);
+    assert(options->threads_c > 0);
+
+    Batch batch;
+    batch.options = options;
+    batch.files_capacity = 16;
+    batch.files_c = 0;
+    batch.files_v = malloc(batch.files_capacity * sizeof(char*));
+    assert(batch.files_v != NULL);
+    atomic_init(&batch.failed, false);
+
+    if (paths_c == 0) {
+        Batch_add_paths_from_stdin(&batch);
+    }
+    for (unsigned int i = 0; i < paths_c; i++) {
+        Batch_add_path(&batch, paths_v[i]);
+    }
+
+    // Every worker can have one Formula waiting for it
+    batch.items_capacity = options->threads_c;
+    batch.items_v = malloc(batch.items_capacity * sizeof(BatchItem));
+    assert(batch.items_v != NULL);
+    batch.items_head = 0;
+    batch.items_c = 0;
+    batch.parsed_c = 0;
+    pthread_mutex_init(&batch.lock, NULL);
+    pthread_cond_init(&batch.not_empty, NULL);
+    pthread_cond_init(&batch.not_full, NULL);
+
+    atomic_init(&batch.next_file, 0);
+
+    // Files of the first round are needed right away
+    for (unsigned int i = 0; i < options->threads_c && i < batch.files_c; i++) {
+        Batch_prefetch(batch.files_v[i]);
+    }
+
+    // As many parsers as workers, so that parsing many small files scales
+    // like solving does
+    pthread_t* parsers_v = malloc(options->threads_c * sizeof(pthread_t));
+    pthread_t* threads_v = malloc(options->threads_c * sizeof(pthread_t));
+    assert(parsers_v != NULL);
+    assert(threads_v != NULL);
+    for (unsigned int i = 0; i < options->threads_c; i++) {
+        int error = pthread_create(&parsers_v[i], NULL, Batch_run_parser, &batch);
+        assert(error == 0);
+        error = pthread_create(&threads_v[i], NULL, Batch_run_worker, &batch);
+        assert(error == 0);
+        (void)error;
+    }
+    for (unsigned int i = 0; i < options->threads_c; i++) {
+        pthread_join(threads_v[i], NULL);
+        pthread_join(parsers_v[i], NULL);
+    }
+    free(parsers_v);
+    free(threads_v);
+
+    pthread_cond_destroy(&batch.not_full);
+    pthread_cond_destroy(&batch.not_empty);
+    pthread_mutex_destroy(&batch.lock);
+    free(batch.items_v);
+
+    for (unsigned int i = 0; i < batch.files_c; i++) {
+        free(batch.files_v[i]);
+    }
+    free(batch.files_v);
+
+    return atomic_load(&batch.failed) ? 1 : 0;
+}
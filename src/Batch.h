@@ -0,0 +1,54 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+#ifndef BATCH_H
+#define BATCH_H
+
+
+#include "Formula.h"
+#include "Parser.h"
+
+
+/**
+ * Settings used for solving every Formula of a batch.
+**/
+typedef struct {
+    ParserFormat format;
+    FormulaEngine engine;
+    DecisionHeuristic decision_heuristic;
+    DecisionPhase decision_phase;
+    unsigned int threads_c;
+} BatchOptions;
+
+
+/**
+ * Parses and solves every given file on a pool of options->threads_c
+ * threads.
+ *
+ * Directories are replaced by the (non-hidden) files they contain. If no
+ * paths are given the paths are read from stdin, one per line.
+ * As many parser threads read and parse the files while the workers
+ * solve, keeping at most one parsed Formula per worker waiting.
+ * For every file one line with its path, its result (SATISFIABLE,
+ * UNSATISFIABLE or ERROR) and the time it took to parse and solve it is
+ * printed as soon as it is done, so lines are not in the given order.
+ *
+ * Returns 0 if all files could be parsed, 1 otherwise.
+**/
+int Batch_run(char** paths_v, unsigned int paths_c, const BatchOptions* options);
+
+
+#endif
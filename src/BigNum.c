@@ -0,0 +1,231 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+
+
+#include "BigNum.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+static void BigNum_reserve(BigNum* number, unsigned int limbs_c) {
+    if (limbs_c <= number->capacity) {
+        return;
+    }
+
+    unsigned int capacity = 2 * number->capacity;
+    if (capacity < limbs_c) {
+        capacity = limbs_c;
+    }
+
+    number->limbs_v = realloc(number->limbs_v, capacity * sizeof(uint32_t));
+    assert(number->limbs_v != NULL);
+    memset(number->limbs_v + number->capacity, 0, (capacity - number->capacity) * sizeof(uint32_t));
+    number->capacity = capacity;
+}
+
+BigNum* BigNum_create(uint64_t value) {
+    BigNum* number = malloc(sizeof(BigNum));
+    assert(number != NULL);
+
+    number->limbs_v = NULL;
+    number->limbs_c = 0;
+    number->capacity = 0;
+    BigNum_reserve(number, 2);
+
+    number->limbs_v[0] = (uint32_t)value;
+    number->limbs_v[1] = (uint32_t)(value >> 32);
+    number->limbs_c = (value >> 32) ? 2 : (value ? 1 : 0);
+
+    return number;
+}
+
+BigNum* BigNum_copy(const BigNum* number) {
+    assert(number != NULL);
+
+    BigNum* copy = BigNum_create(0);
+    BigNum_reserve(copy, number->limbs_c);
+    memcpy(copy->limbs_v, number->limbs_v, number->limbs_c * sizeof(uint32_t));
+    copy->limbs_c = number->limbs_c;
+
+    return copy;
+}
+
+void BigNum_destroy(BigNum* number) {
+    assert(number != NULL);
+
+    free(number->limbs_v);
+    free(number);
+}
+
+void BigNum_add_power_of_two(BigNum* number, unsigned int exponent) {
+    assert(number != NULL);
+
+    // Limbs above the most significant one may be stale
+    unsigned int limb = exponent / 32;
+    BigNum_reserve(number, limb + 2);
+    if (number->limbs_c < limb + 1) {
+        memset(number->limbs_v + number->limbs_c, 0, (limb + 1 - number->limbs_c) * sizeof(uint32_t));
+        number->limbs_c = limb + 1;
+    }
+
+    // Carry into higher limbs until a limb does not overflow
+    uint64_t carry = (uint64_t)1 << (exponent % 32);
+    for (unsigned int i = limb; carry != 0; i++) {
+        if (i == number->limbs_c) {
+            BigNum_reserve(number, i + 1);
+            number->limbs_v[i] = 0;
+            number->limbs_c = i + 1;
+        }
+
+        uint64_t sum = (uint64_t)number->limbs_v[i] + carry;
+        number->limbs_v[i] = (uint32_t)sum;
+        carry = sum >> 32;
+    }
+}
+
+void BigNum_add(BigNum* number, const BigNum* addend) {
+    assert(number != NULL);
+    assert(addend != NULL);
+
+    unsigned int limbs_c = (number->limbs_c > addend->limbs_c) ? number->limbs_c : addend->limbs_c;
+    BigNum_reserve(number, limbs_c + 1);
+
+    uint64_t carry = 0;
+    for (unsigned int i = 0; i < limbs_c; i++) {
+        uint64_t sum = carry;
+        if (i < number->limbs_c) {
+            sum += number->limbs_v[i];
+        }
+        if (i < addend->limbs_c) {
+            sum += addend->limbs_v[i];
+        }
+        number->limbs_v[i] = (uint32_t)sum;
+        carry = sum >> 32;
+    }
+    number->limbs_v[limbs_c] = (uint32_t)carry;
+    number->limbs_c = limbs_c + (carry != 0);
+}
+
+void BigNum_multiply(BigNum* number, const BigNum* factor) {
+    assert(number != NULL);
+    assert(factor != NULL);
+
+    if (BigNum_is_zero(number) || BigNum_is_zero(factor)) {
+        number->limbs_c = 0;
+        return;
+    }
+
+    // Schoolbook multiplication into a new array of limbs
+    unsigned int limbs_c = number->limbs_c + factor->limbs_c;
+    uint32_t* product_v = calloc(limbs_c, sizeof(uint32_t));
+    assert(product_v != NULL);
+
+    for (unsigned int i = 0; i < number->limbs_c; i++) {
+        uint64_t carry = 0;
+        for (unsigned int j = 0; j < factor->limbs_c; j++) {
+            uint64_t value = (uint64_t)number->limbs_v[i] * factor->limbs_v[j] + product_v[i + j] + carry;
+            product_v[i + j] = (uint32_t)value;
+            carry = value >> 32;
+        }
+        product_v[i + factor->limbs_c] = (uint32_t)carry;
+    }
+
+    BigNum_reserve(number, limbs_c);
+    memcpy(number->limbs_v, product_v, limbs_c * sizeof(uint32_t));
+    free(product_v);
+
+    number->limbs_c = limbs_c;
+    while (number->limbs_v[number->limbs_c - 1] == 0) {
+        number->limbs_c--;
+    }
+}
+
+void BigNum_shift_left(BigNum* number, unsigned int exponent) {
+    assert(number != NULL);
+
+    if (BigNum_is_zero(number) || exponent == 0) {
+        return;
+    }
+
+    unsigned int limbs = exponent / 32;
+    unsigned int bits = exponent % 32;
+    BigNum_reserve(number, number->limbs_c + limbs + 1);
+
+    // Move limbs up starting with the most significant one
+    number->limbs_v[number->limbs_c + limbs] = 0;
+    for (unsigned int i = number->limbs_c; i > 0; i--) {
+        uint64_t value = (uint64_t)number->limbs_v[i - 1] << bits;
+        number->limbs_v[i + limbs] |= (uint32_t)(value >> 32);
+        number->limbs_v[i - 1 + limbs] = (uint32_t)value;
+    }
+    memset(number->limbs_v, 0, limbs * sizeof(uint32_t));
+
+    number->limbs_c += limbs + 1;
+    while (number->limbs_v[number->limbs_c - 1] == 0) {
+        number->limbs_c--;
+    }
+}
+
+char* BigNum_to_string(const BigNum* number) {
+    assert(number != NULL);
+
+    // Every 32 bits need at most 10 decimal digits
+    char* str = malloc(10 * number->limbs_c + 2);
+    assert(str != NULL);
+
+    // Repeatedly divide a copy by 10^9 and collect the remainders, which
+    // are the groups of 9 digits from the least significant one
+    uint32_t* limbs_v = malloc((number->limbs_c + 1) * sizeof(uint32_t));
+    assert(limbs_v != NULL);
+    memcpy(limbs_v, number->limbs_v, number->limbs_c * sizeof(uint32_t));
+    unsigned int limbs_c = number->limbs_c;
+
+    uint32_t* groups_v = malloc((2 * number->limbs_c + 1) * sizeof(uint32_t));
+    assert(groups_v != NULL);
+    unsigned int groups_c = 0;
+
+    while (limbs_c > 0 && limbs_v[limbs_c - 1] == 0) {
+        limbs_c--;
+    }
+    while (limbs_c > 0) {
+        uint64_t remainder = 0;
+        for (unsigned int i = limbs_c; i > 0; i--) {
+            uint64_t value = (remainder << 32) | limbs_v[i - 1];
+            limbs_v[i - 1] = (uint32_t)(value / 1000000000);
+            remainder = value % 1000000000;
+        }
+        groups_v[groups_c++] = (uint32_t)remainder;
+
+        while (limbs_c > 0 && limbs_v[limbs_c - 1] == 0) {
+            limbs_c--;
+        }
+    }
+
+    // Only the most significant group is printed without leading zeros
+    int length = sprintf(str, "%u", (groups_c > 0) ? groups_v[groups_c - 1] : 0);
+    for (unsigned int i = groups_c - (groups_c > 0); i > 0; i--) {
+        length += sprintf(str + length, "%09u", groups_v[i - 1]);
+    }
+
+    free(groups_v);
+    free(limbs_v);
+
+    return str;
+}
@@ -0,0 +1,77 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+
+
+#ifndef BIGNUM_H
+#define BIGNUM_H
+
+
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/**
+ * Non-negative integer of arbitrary size, as model counts easily exceed
+ * every machine integer.
+ *
+ * Stored as limbs of 32 bits with the least significant limb first, the
+ * most significant limb is never 0 (so 0 has no limbs).
+**/
+typedef struct {
+    uint32_t* limbs_v;
+    unsigned int limbs_c;
+    unsigned int capacity;
+} BigNum;
+
+
+BigNum* BigNum_create(uint64_t value);
+
+BigNum* BigNum_copy(const BigNum* number);
+
+void BigNum_destroy(BigNum* number);
+
+static inline bool BigNum_is_zero(const BigNum* number) {
+    return number->limbs_c == 0;
+}
+
+/**
+ * Adds addend to the number.
+**/
+void BigNum_add(BigNum* number, const BigNum* addend);
+
+/**
+ * Adds 2^exponent to the number.
+**/
+void BigNum_add_power_of_two(BigNum* number, unsigned int exponent);
+
+/**
+ * Multiplies the number by factor.
+**/
+void BigNum_multiply(BigNum* number, const BigNum* factor);
+
+/**
+ * Multiplies the number by 2^exponent.
+**/
+void BigNum_shift_left(BigNum* number, unsigned int exponent);
+
+/**
+ * Represent the number in decimal as a string.
+**/
+char* BigNum_to_string(const BigNum* number);
+
+
+#endif
@@ -19,52 +19,12 @@
 #include "StringBuilder.h"
 
 #include <assert.h>
-#include <string.h>
 
 
-Clause* Clause_create(Literal** literals_v, unsigned int literals_c) {
-    assert(literals_v != NULL);
-
-    Clause* clause = malloc(sizeof(Clause));
-    assert(clause != NULL);
-
-    clause->literals_v = literals_v;
-    clause->literals_c = literals_c;
-    clause->clause_status = ClauseStatus_UNDECIDED;
-
-    return clause;
-}
-
-void Clause_destroy(Clause* clause) {
-    assert(clause != NULL);
-
-    // Free all Literals
-    for (unsigned int i = 0; i < clause->literals_c; i++) {
-        Literal_destroy(clause->literals_v[i]);
-    }
-    free(clause->literals_v);
-
-    // Free Clause
-    free(clause);
-}
-
-Clause* Clause_clone(Clause* clause) {
-    // Clone array of Literals
-    unsigned int count = clause->literals_c;
-    Literal** cloned_array = malloc(count * sizeof(Literal*));
-    assert(cloned_array != NULL);
-
-    for (unsigned int i = 0; i < count; i++) {
-        Literal* literal = clause->literals_v[i];
-        cloned_array[i] = Literal_clone(literal);
-    }
-
-    // Create Clause from list of Literals
-    return Clause_create(cloned_array, count);
-}
-
-char* Clause_to_string(Clause* clause, bool color) {
+char* Clause_to_string(Clause* clause, char** names_v, LiteralAssignment* assignments_v, bool color) {
     assert(clause != NULL);
+    assert(names_v != NULL);
+    assert(assignments_v != NULL);
 
     StringBuilder* builder = StringBuilder_create(30);
 
@@ -89,7 +49,9 @@ char* Clause_to_string(Clause* clause, bool color) {
     // Add all Literals contained in this Clause
     for (unsigned int i = 0; i  < clause->literals_c; i++) {
         // Add Literal string
-        char* lit_str = Literal_to_string(clause->literals_v[i], color);
+        Literal literal = clause->literals_v[i];
+        Variable variable = Literal_get_variable(literal);
+        char* lit_str = Literal_to_string(literal, names_v[variable], assignments_v[variable], color);
         StringBuilder_append_string(builder, lit_str);
         free(lit_str);
 
@@ -121,40 +83,12 @@ char* Clause_to_string(Clause* clause, bool color) {
     return StringBuilder_destroy_to_string(builder);
 }
 
-Literal* Clause_is_unit_clause(Clause* clause) {
-    assert(clause != NULL);
-
-    // If all but one Literal are assigned return true.
-    // If there are more than one unassigned Literal return false.
-    bool found_unassigned_literal = false;
-    Literal* only_literal = NULL;
-
-    for (unsigned int i = 0; i < clause->literals_c; i++) {
-        Literal* literal = clause->literals_v[i];
-        LiteralAssignment assignment = GenericLiteral_get_assignment(literal->generic_literal);
-
-        if (assignment == LiteralAssignment_UNSET) {
-            // If we found an unassigned Literal previously there are
-            // multiple unassigned Literals in this Clause.
-            if (found_unassigned_literal) {
-                return NULL;
-            }
-
-            found_unassigned_literal = true;
-            only_literal = literal;
-        }
-    }
-
-    return only_literal;
-}
-
-ClauseStatus Clause_evaluate(Clause* clause) {
+ClauseStatus Clause_evaluate(Clause* clause, LiteralAssignment* assignments_v) {
     bool all_literals_are_false = true;
 
     // Check all Literals in this clause
     for (unsigned int i = 0; i < clause->literals_c; i++) {
-        Literal* literal = clause->literals_v[i];
-        LiteralAssignment assignment = GenericLiteral_get_assignment(literal->generic_literal);
+        LiteralAssignment assignment = Literal_evaluate(clause->literals_v[i], assignments_v);
 
         // If there are any Literals in this Clause that are UNSET
         // this Clause cannot be false
@@ -163,19 +97,15 @@ ClauseStatus Clause_evaluate(Clause* clause) {
             continue;
         }
 
-        if (assignment != LiteralAssignment_UNSET) {
-            bool b = (assignment == LiteralAssignment_TRUE) ? true : false;
-
-            // If any Literal is true this Clause is true
-            if (b == !literal->negated) {
-                clause->clause_status = ClauseStatus_TRUE;
-                return clause->clause_status;
-            } else {
-                // If a Literal is false but there are other Literals in this
-                // Clause that are true or unset everything is fine and this Clause
-                // is not yet false.
-            }
+        // If any Literal is true this Clause is true
+        if (assignment == LiteralAssignment_TRUE) {
+            clause->clause_status = ClauseStatus_TRUE;
+            return clause->clause_status;
         }
+
+        // If a Literal is false but there are other Literals in this
+        // Clause that are true or unset everything is fine and this Clause
+        // is not yet false.
     }
 
     // If all Literals are false this Clause is false.
@@ -186,5 +116,7 @@ ClauseStatus Clause_evaluate(Clause* clause) {
 
     // If this Clause is neither true nor false it is undecided.
     clause->clause_status = ClauseStatus_UNDECIDED;
+    clause->true_c = 0;
+    clause->false_c = 0;
     return clause->clause_status;
 }
@@ -19,9 +19,9 @@
 
 
 #include "Literal.h"
-#include "LinkedList.h"
 
 #include <stdbool.h>
+#include <stdint.h>
 
 
 /**
@@ -42,51 +42,51 @@ typedef enum {
  *
  * A Clause contains Literals.
  * For a Clause to be true at least one contained Literal has to be true.
+ *
+ * Clauses only live inside a ClauseArena, the contained Literals are
+ * stored right behind the header.
 **/
 typedef struct {
-    Literal** literals_v;
     unsigned int literals_c;
     ClauseStatus clause_status;
-} Clause;
 
+    // Number of contained Literals that are currently true / false.
+    // Only kept up to date while the Formula tracks Clause status.
+    unsigned int true_c;
+    unsigned int false_c;
 
-/**
- * Creates a new Clause.
-**/
-Clause* Clause_create(Literal** literals_v, unsigned int literals_c);
+    // Position of this Clause in the ClauseArena it was moved to during
+    // garbage collection. Only valid if relocated is set.
+    uint32_t relocation;
 
-/**
- * Destroys a Clause.
-**/
-void Clause_destroy(Clause* clause);
+    bool learned;
+    bool deleted;
+    bool relocated;
 
-/**
- * Copy this object.
- *
- * Note: Contained Literals don't get copied!
-**/
-Clause* Clause_clone(Clause* clause);
+    // Whether the Clause took part in finding a conflict.
+    // Only kept up to date while the Formula collects an unsatisfiable
+    // core.
+    bool core;
+
+    Literal literals_v[];
+} Clause;
 
-/**
- * Represent Clause as a string.
-**/
-char* Clause_to_string(Clause* clause, bool color);
 
 /**
- * Decides whether a given Clause is a unit Clause (only contains one single
- * unassigned Literal).
+ * Represent Clause as a string.
  *
- * If a given Clause is a unit Clause its only unassigned Literal is returned.
- * If a given Clause is not a unit Clause NULL is returned.
+ * Names and assignments of all Variables are needed to represent the
+ * contained Literals.
 **/
-Literal* Clause_is_unit_clause(Clause* clause);
+char* Clause_to_string(Clause* clause, char** names_v, LiteralAssignment* assignments_v, bool color);
 
 /**
  * Evaluates a given Clause according to logical rules.
  *
- * Returns the status of a given Clause after evaluating all its Literals.
+ * Returns the status of a given Clause after evaluating all its Literals
+ * with the given assignments of all Variables.
 **/
-ClauseStatus Clause_evaluate(Clause* clause);
+ClauseStatus Clause_evaluate(Clause* clause, LiteralAssignment* assignments_v);
 
 
 #endif
@@ -0,0 +1,152 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+
+
+#include "ClauseArena.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/**
+ * Number of words occupied by a Clause with the given number of Literals.
+**/
+static inline uint32_t ClauseArena_clause_words(unsigned int literals_c) {
+    return (sizeof(Clause) + literals_c * sizeof(Literal)) / sizeof(uint32_t);
+}
+
+ClauseArena* ClauseArena_create(uint32_t capacity) {
+    // Clauses are stored as whole words
+    assert(sizeof(Clause) % sizeof(uint32_t) == 0);
+    assert(sizeof(Literal) == sizeof(uint32_t));
+
+    if (capacity == 0) {
+        capacity = 1;
+    }
+
+    ClauseArena* arena = malloc(sizeof(ClauseArena));
+    assert(arena != NULL);
+
+    arena->data = malloc(capacity * sizeof(uint32_t));
+    assert(arena->data != NULL);
+    arena->size = 0;
+    arena->capacity = capacity;
+    arena->wasted = 0;
+
+    return arena;
+}
+
+void ClauseArena_destroy(ClauseArena* arena) {
+    assert(arena != NULL);
+
+    free(arena->data);
+    free(arena);
+}
+
+ClauseRef ClauseArena_add(ClauseArena* arena, const Literal* literals_v, unsigned int literals_c, bool learned) {
+    assert(arena != NULL);
+    assert(literals_v != NULL || literals_c == 0);
+
+    uint32_t words = ClauseArena_clause_words(literals_c);
+
+    // References have to fit into 32 bits
+    assert((uint64_t)arena->size + words < CLAUSEREF_UNDEF);
+
+    // Resize if necessary
+    if (arena->size + words > arena->capacity) {
+        uint64_t capacity = arena->capacity;
+        while (capacity < (uint64_t)arena->size + words) {
+            capacity *= 2;
+        }
+        if (capacity > CLAUSEREF_UNDEF) {
+            capacity = CLAUSEREF_UNDEF;
+        }
+
+        arena->capacity = capacity;
+        arena->data = realloc(arena->data, arena->capacity * sizeof(uint32_t));
+        assert(arena->data != NULL);
+    }
+
+    ClauseRef ref = arena->size;
+    arena->size += words;
+
+    Clause* clause = ClauseArena_get(arena, ref);
+    clause->literals_c = literals_c;
+    clause->clause_status = ClauseStatus_UNDECIDED;
+    clause->true_c = 0;
+    clause->false_c = 0;
+    clause->relocation = CLAUSEREF_UNDEF;
+    clause->learned = learned;
+    clause->deleted = false;
+    clause->relocated = false;
+    clause->core = false;
+    if (literals_c > 0) {
+        memcpy(clause->literals_v, literals_v, literals_c * sizeof(Literal));
+    }
+
+    return ref;
+}
+
+void ClauseArena_delete(ClauseArena* arena, ClauseRef ref) {
+    assert(arena != NULL);
+    assert(ref < arena->size);
+
+    Clause* clause = ClauseArena_get(arena, ref);
+    assert(!clause->deleted);
+
+    clause->deleted = true;
+    arena->wasted += ClauseArena_clause_words(clause->literals_c);
+}
+
+void ClauseArena_shrink_clause(ClauseArena* arena, ClauseRef ref, unsigned int literals_c) {
+    assert(arena != NULL);
+    assert(ref < arena->size);
+
+    Clause* clause = ClauseArena_get(arena, ref);
+    assert(literals_c <= clause->literals_c);
+
+    arena->wasted += clause->literals_c - literals_c;
+    clause->literals_c = literals_c;
+}
+
+void ClauseArena_relocate(ClauseArena* from, ClauseArena* to, ClauseRef* ref) {
+    assert(from != NULL);
+    assert(to != NULL);
+    assert(*ref < from->size);
+
+    Clause* clause = ClauseArena_get(from, *ref);
+    assert(!clause->deleted);
+
+    // Clause was already moved
+    if (clause->relocated) {
+        *ref = clause->relocation;
+        return;
+    }
+
+    // Move Clause along with its status
+    ClauseRef new_ref = ClauseArena_add(to, clause->literals_v, clause->literals_c, clause->learned);
+    Clause* new_clause = ClauseArena_get(to, new_ref);
+    new_clause->clause_status = clause->clause_status;
+    new_clause->true_c = clause->true_c;
+    new_clause->false_c = clause->false_c;
+    new_clause->core = clause->core;
+
+    clause->relocated = true;
+    clause->relocation = new_ref;
+    *ref = new_ref;
+}
@@ -0,0 +1,105 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+
+
+#ifndef CLAUSEARENA_H
+#define CLAUSEARENA_H
+
+
+#include "Clause.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/**
+ * Reference to a Clause inside a ClauseArena.
+ *
+ * References stay valid when the arena grows, pointers to Clauses do not.
+**/
+typedef uint32_t ClauseRef;
+
+/**
+ * Reference that does not point to any Clause.
+**/
+#define CLAUSEREF_UNDEF UINT32_MAX
+
+/**
+ * Contiguous storage for Clauses.
+ *
+ * Every Clause is stored as its header directly followed by its Literals.
+ * Clauses are referenced by their offset (in words) from the start of the
+ * buffer.
+ * Deleted Clauses keep occupying their space until the arena is compacted
+ * by relocating all Clauses that are still in use into a new arena.
+**/
+typedef struct {
+    uint32_t* data;
+    uint32_t size;
+    uint32_t capacity;
+
+    // Number of words occupied by deleted Clauses or removed Literals
+    uint32_t wasted;
+} ClauseArena;
+
+
+/**
+ * Creates a new ClauseArena with room for capacity words.
+**/
+ClauseArena* ClauseArena_create(uint32_t capacity);
+
+/**
+ * Destroys a ClauseArena and all Clauses in it.
+**/
+void ClauseArena_destroy(ClauseArena* arena);
+
+/**
+ * Copies the given Literals into a new Clause at the end of the arena.
+**/
+ClauseRef ClauseArena_add(ClauseArena* arena, const Literal* literals_v, unsigned int literals_c, bool learned);
+
+/**
+ * Marks a Clause as deleted, its space is reclaimed by the next
+ * compaction.
+**/
+void ClauseArena_delete(ClauseArena* arena, ClauseRef ref);
+
+/**
+ * Removes all but the first literals_c Literals from a Clause.
+**/
+void ClauseArena_shrink_clause(ClauseArena* arena, ClauseRef ref, unsigned int literals_c);
+
+/**
+ * Moves the referenced Clause from one arena into another one and
+ * updates the reference.
+ *
+ * Every Clause is moved only once, further references to the same Clause
+ * are updated to its new position.
+**/
+void ClauseArena_relocate(ClauseArena* from, ClauseArena* to, ClauseRef* ref);
+
+/**
+ * Returns the Clause at the given position.
+ *
+ * The pointer is only valid until the next Clause is added.
+**/
+static inline Clause* ClauseArena_get(ClauseArena* arena, ClauseRef ref) {
+    return (Clause*)(arena->data + ref);
+}
+
+
+#endif
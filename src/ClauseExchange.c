@@ -0,0 +1,191 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+#include "ClauseExchange.h"
+
+#include <assert.h>
+
+
+#define CLAUSEEXCHANGE_RING_MASK (CLAUSEEXCHANGE_RING_CAPACITY - 1)
+
+
+ClauseExchange* ClauseExchange_create(unsigned int rings_c, unsigned int max_size, unsigned int max_lbd) {
+    assert(rings_c > 0);
+    assert(max_size > 0 && max_size < CLAUSEEXCHANGE_RING_CAPACITY);
+
+    ClauseExchange* exchange = malloc(sizeof(ClauseExchange));
+    assert(exchange != NULL);
+
+    exchange->rings_v = malloc(rings_c * sizeof(ClauseExchangeRing));
+    assert(exchange->rings_v != NULL);
+    exchange->rings_c = rings_c;
+    exchange->max_size = max_size;
+    exchange->max_lbd = max_lbd;
+
+    for (unsigned int i = 0; i < rings_c; i++) {
+        ClauseExchangeRing* ring = &exchange->rings_v[i];
+
+        ring->data = malloc(CLAUSEEXCHANGE_RING_CAPACITY * sizeof(_Atomic(uint32_t)));
+        assert(ring->data != NULL);
+        for (unsigned int p = 0; p < CLAUSEEXCHANGE_RING_CAPACITY; p++) {
+            atomic_init(&ring->data[p], 0);
+        }
+        atomic_init(&ring->reserved, 0);
+        atomic_init(&ring->written, 0);
+    }
+
+    return exchange;
+}
+
+void ClauseExchange_destroy(ClauseExchange* exchange) {
+    assert(exchange != NULL);
+
+    for (unsigned int i = 0; i < exchange->rings_c; i++) {
+        free(exchange->rings_v[i].data);
+    }
+    free(exchange->rings_v);
+    free(exchange);
+}
+
+ClauseExchangePort* ClauseExchangePort_create(ClauseExchange* exchange, unsigned int id) {
+    assert(exchange != NULL);
+    assert(id < exchange->rings_c);
+
+    ClauseExchangePort* port = malloc(sizeof(ClauseExchangePort));
+    assert(port != NULL);
+
+    port->exchange = exchange;
+    port->id = id;
+    port->next_ring = 0;
+
+    port->positions_v = malloc(exchange->rings_c * sizeof(uint64_t));
+    assert(port->positions_v != NULL);
+    for (unsigned int i = 0; i < exchange->rings_c; i++) {
+        port->positions_v[i] = atomic_load(&exchange->rings_v[i].written);
+    }
+
+    port->literals_v = malloc(exchange->max_size * sizeof(Literal));
+    assert(port->literals_v != NULL);
+
+    return port;
+}
+
+void ClauseExchangePort_destroy(ClauseExchangePort* port) {
+    assert(port != NULL);
+
+    free(port->positions_v);
+    free(port->literals_v);
+    free(port);
+}
+
+void ClauseExchangePort_export(ClauseExchangePort* port, const Literal* literals_v, unsigned int literals_c, unsigned int lbd) {
+    assert(port != NULL);
+    assert(literals_c > 0);
+
+    ClauseExchange* exchange = port->exchange;
+    if (literals_c > exchange->max_size || lbd > exchange->max_lbd) {
+        return;
+    }
+
+    // Only this thread writes to its ring
+    ClauseExchangeRing* ring = &exchange->rings_v[port->id];
+    uint64_t position = atomic_load_explicit(&ring->written, memory_order_relaxed);
+    uint64_t end = position + 1 + literals_c;
+
+    // Announce which words are about to be overwritten before touching
+    // them
+    atomic_store_explicit(&ring->reserved, end, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    atomic_store_explicit(&ring->data[position & CLAUSEEXCHANGE_RING_MASK], literals_c, memory_order_relaxed);
+    for (unsigned int i = 0; i < literals_c; i++) {
+        atomic_store_explicit(&ring->data[(position + 1 + i) & CLAUSEEXCHANGE_RING_MASK],
+                              literals_v[i],
+                              memory_order_relaxed);
+    }
+
+    atomic_store_explicit(&ring->written, end, memory_order_release);
+}
+
+/**
+ * Reads the Clause at the current position of the port in the given ring.
+ *
+ * Returns false if the ring contains no new Clause. Clauses that were
+ * overwritten before they could be read are skipped.
+**/
+static bool ClauseExchangePort_read(ClauseExchangePort* port, unsigned int index, unsigned int* literals_c) {
+    ClauseExchangeRing* ring = &port->exchange->rings_v[index];
+
+    while (true) {
+        uint64_t position = port->positions_v[index];
+        uint64_t written = atomic_load_explicit(&ring->written, memory_order_acquire);
+
+        if (position == written) {
+            return false;
+        }
+
+        // Reader fell behind by more than the whole ring
+        if (written - position > CLAUSEEXCHANGE_RING_CAPACITY) {
+            port->positions_v[index] = written;
+            continue;
+        }
+
+        uint32_t size = atomic_load_explicit(&ring->data[position & CLAUSEEXCHANGE_RING_MASK], memory_order_relaxed);
+        if (size == 0 || size > port->exchange->max_size) {
+            // Header was overwritten already
+            port->positions_v[index] = written;
+            continue;
+        }
+        for (unsigned int i = 0; i < size; i++) {
+            port->literals_v[i] = atomic_load_explicit(&ring->data[(position + 1 + i) & CLAUSEEXCHANGE_RING_MASK],
+                                                       memory_order_relaxed);
+        }
+
+        // Discard the Clause if the writer started overwriting it while
+        // it was read
+        atomic_thread_fence(memory_order_acquire);
+        uint64_t reserved = atomic_load_explicit(&ring->reserved, memory_order_relaxed);
+        if (reserved - position > CLAUSEEXCHANGE_RING_CAPACITY) {
+            port->positions_v[index] = written;
+            continue;
+        }
+
+        port->positions_v[index] = position + 1 + size;
+        *literals_c = size;
+        return true;
+    }
+}
+
+bool ClauseExchangePort_import(ClauseExchangePort* port, const Literal** literals_v, unsigned int* literals_c) {
+    assert(port != NULL);
+    assert(literals_v != NULL);
+    assert(literals_c != NULL);
+
+    // Go through the rings of all other solvers in turn
+    unsigned int rings_c = port->exchange->rings_c;
+    for (unsigned int checked = 0; checked < rings_c; checked++) {
+        unsigned int index = port->next_ring;
+
+        if (index != port->id && ClauseExchangePort_read(port, index, literals_c)) {
+            *literals_v = port->literals_v;
+            return true;
+        }
+
+        port->next_ring = (index + 1) % rings_c;
+    }
+
+    return false;
+}
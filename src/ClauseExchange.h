@@ -0,0 +1,126 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+#ifndef CLAUSEEXCHANGE_H
+#define CLAUSEEXCHANGE_H
+
+
+#include "Literal.h"
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/**
+ * Number of words in the ring buffer of every solver.
+ * Must be a power of two.
+**/
+#define CLAUSEEXCHANGE_RING_CAPACITY (1u << 16)
+
+/**
+ * Ring buffer into which a single solver writes the Clauses it shares.
+ *
+ * Every Clause is stored as its number of Literals followed by the
+ * Literals. Positions count all words ever written, the ring never blocks
+ * and simply overwrites Clauses that readers did not pick up in time.
+ * Before a Clause is written reserved is advanced to its end, after it is
+ * complete written is advanced as well. Readers compare their position
+ * with reserved after reading a Clause to notice whether it was
+ * overwritten in the meantime.
+**/
+typedef struct {
+    _Atomic(uint32_t)* data;
+    _Atomic(uint64_t) reserved;
+    _Atomic(uint64_t) written;
+} ClauseExchangeRing;
+
+/**
+ * Lock-free exchange of learned Clauses between solvers running in
+ * parallel on copies of the same Formula.
+ *
+ * Every solver owns one ring it writes to and reads the rings of all
+ * other solvers. Only Clauses with at most max_size Literals and at most
+ * max_lbd different decision levels are shared.
+**/
+typedef struct {
+    ClauseExchangeRing* rings_v;
+    unsigned int rings_c;
+
+    unsigned int max_size;
+    unsigned int max_lbd;
+} ClauseExchange;
+
+/**
+ * Access of a single solver to a ClauseExchange.
+ *
+ * A port must only be used by one thread at a time.
+**/
+typedef struct {
+    ClauseExchange* exchange;
+    unsigned int id;
+
+    // Position up to which every ring has been read and the ring to
+    // continue reading with
+    uint64_t* positions_v;
+    unsigned int next_ring;
+
+    // Buffer for the Literals of the last imported Clause
+    Literal* literals_v;
+} ClauseExchangePort;
+
+
+/**
+ * Creates a new ClauseExchange for rings_c solvers.
+**/
+ClauseExchange* ClauseExchange_create(unsigned int rings_c, unsigned int max_size, unsigned int max_lbd);
+
+/**
+ * Destroys a ClauseExchange, all its ports have to be destroyed already.
+**/
+void ClauseExchange_destroy(ClauseExchange* exchange);
+
+/**
+ * Creates the port of the solver with the given id (below rings_c).
+ *
+ * The port only sees Clauses that are exported after its creation.
+**/
+ClauseExchangePort* ClauseExchangePort_create(ClauseExchange* exchange, unsigned int id);
+
+/**
+ * Destroys a ClauseExchangePort.
+**/
+void ClauseExchangePort_destroy(ClauseExchangePort* port);
+
+/**
+ * Offers a learned Clause to all other solvers.
+ *
+ * lbd is the number of different decision levels of the Literals of the
+ * Clause. Clauses that are too long or have a too high lbd are dropped.
+**/
+void ClauseExchangePort_export(ClauseExchangePort* port, const Literal* literals_v, unsigned int literals_c, unsigned int lbd);
+
+/**
+ * Fetches the next Clause exported by any other solver.
+ *
+ * Returns false if there are no new Clauses. Otherwise the Literals of
+ * the Clause are written to literals_v (valid until the next call) and
+ * literals_c.
+**/
+bool ClauseExchangePort_import(ClauseExchangePort* port, const Literal** literals_v, unsigned int* literals_c);
+
+
+#endif
@@ -0,0 +1,66 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+
+
+#include "ClauseRefVector.h"
+
+#include <assert.h>
+#include <stdlib.h>
+
+
+ClauseRefVector* ClauseRefVector_create(unsigned int capacity) {
+    if (capacity == 0) {
+        capacity = 1;
+    }
+
+    ClauseRefVector* vector = malloc(sizeof(ClauseRefVector));
+    assert(vector != NULL);
+
+    vector->data = malloc(capacity * sizeof(ClauseRef));
+    assert(vector->data != NULL);
+    vector->size = 0;
+    vector->capacity = capacity;
+
+    return vector;
+}
+
+void ClauseRefVector_destroy(ClauseRefVector* vector) {
+    assert(vector != NULL);
+
+    free(vector->data);
+    free(vector);
+}
+
+void ClauseRefVector_append(ClauseRefVector* vector, ClauseRef ref) {
+    assert(vector != NULL);
+
+    // Resize if necessary
+    if (vector->size == vector->capacity) {
+        vector->capacity *= 2;
+        vector->data = realloc(vector->data, vector->capacity * sizeof(ClauseRef));
+        assert(vector->data != NULL);
+    }
+
+    vector->data[vector->size++] = ref;
+}
+
+void ClauseRefVector_shrink(ClauseRefVector* vector, unsigned int size) {
+    assert(vector != NULL);
+    assert(size <= vector->size);
+
+    vector->size = size;
+}
@@ -0,0 +1,47 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+
+
+#ifndef CLAUSEREFVECTOR_H
+#define CLAUSEREFVECTOR_H
+
+
+#include "ClauseArena.h"
+
+
+/**
+ * Growable array of references to Clauses.
+ *
+ * Elements can be accessed directly through data[0] ... data[size - 1].
+**/
+typedef struct {
+    ClauseRef* data;
+    unsigned int size;
+    unsigned int capacity;
+} ClauseRefVector;
+
+
+ClauseRefVector* ClauseRefVector_create(unsigned int capacity);
+
+void ClauseRefVector_destroy(ClauseRefVector* vector);
+
+void ClauseRefVector_append(ClauseRefVector* vector, ClauseRef ref);
+
+void ClauseRefVector_shrink(ClauseRefVector* vector, unsigned int size);
+
+
+#endif
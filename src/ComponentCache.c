@@ -0,0 +1,211 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+
+
+#include "ComponentCache.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+static uint64_t ComponentCache_hash(const uint32_t* key_v, unsigned int key_c) {
+    // FNV-1a over whole words followed by a final mix, so that the low
+    // bits used to pick the bucket depend on all words
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned int i = 0; i < key_c; i++) {
+        hash ^= key_v[i];
+        hash *= 1099511628211ULL;
+    }
+
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+
+    return hash;
+}
+
+static size_t ComponentCache_entry_memory(const ComponentCacheEntry* entry) {
+    return sizeof(ComponentCacheEntry) + sizeof(BigNum) +
+           entry->key_c * sizeof(uint32_t) +
+           entry->count->capacity * sizeof(uint32_t);
+}
+
+static void ComponentCache_unlink(ComponentCache* cache, ComponentCacheEntry* entry) {
+    if (entry->newer != NULL) {
+        entry->newer->older = entry->older;
+    } else {
+        cache->newest = entry->older;
+    }
+
+    if (entry->older != NULL) {
+        entry->older->newer = entry->newer;
+    } else {
+        cache->oldest = entry->newer;
+    }
+}
+
+static void ComponentCache_link_newest(ComponentCache* cache, ComponentCacheEntry* entry) {
+    entry->newer = NULL;
+    entry->older = cache->newest;
+
+    if (cache->newest != NULL) {
+        cache->newest->newer = entry;
+    } else {
+        cache->oldest = entry;
+    }
+    cache->newest = entry;
+}
+
+static void ComponentCache_evict_oldest(ComponentCache* cache) {
+    ComponentCacheEntry* entry = cache->oldest;
+    ComponentCache_unlink(cache, entry);
+
+    // Remove from its bucket
+    ComponentCacheEntry** link = &cache->buckets_v[entry->hash & (cache->buckets_c - 1)];
+    while (*link != entry) {
+        link = &(*link)->bucket_next;
+    }
+    *link = entry->bucket_next;
+
+    cache->memory -= ComponentCache_entry_memory(entry);
+    cache->entries_c--;
+
+    BigNum_destroy(entry->count);
+    free(entry->key_v);
+    free(entry);
+}
+
+static void ComponentCache_grow(ComponentCache* cache) {
+    unsigned int buckets_c = 2 * cache->buckets_c;
+    ComponentCacheEntry** buckets_v = calloc(buckets_c, sizeof(ComponentCacheEntry*));
+    assert(buckets_v != NULL);
+
+    for (unsigned int i = 0; i < cache->buckets_c; i++) {
+        ComponentCacheEntry* entry = cache->buckets_v[i];
+        while (entry != NULL) {
+            ComponentCacheEntry* next = entry->bucket_next;
+            unsigned int bucket = entry->hash & (buckets_c - 1);
+            entry->bucket_next = buckets_v[bucket];
+            buckets_v[bucket] = entry;
+            entry = next;
+        }
+    }
+
+    cache->memory += (buckets_c - cache->buckets_c) * sizeof(ComponentCacheEntry*);
+    free(cache->buckets_v);
+    cache->buckets_v = buckets_v;
+    cache->buckets_c = buckets_c;
+}
+
+ComponentCache* ComponentCache_create(size_t memory_limit) {
+    ComponentCache* cache = malloc(sizeof(ComponentCache));
+    assert(cache != NULL);
+
+    cache->buckets_c = 1024;
+    cache->buckets_v = calloc(cache->buckets_c, sizeof(ComponentCacheEntry*));
+    assert(cache->buckets_v != NULL);
+    cache->entries_c = 0;
+
+    cache->newest = NULL;
+    cache->oldest = NULL;
+
+    cache->memory = cache->buckets_c * sizeof(ComponentCacheEntry*);
+    cache->memory_limit = memory_limit;
+
+    return cache;
+}
+
+void ComponentCache_destroy(ComponentCache* cache) {
+    assert(cache != NULL);
+
+    ComponentCacheEntry* entry = cache->oldest;
+    while (entry != NULL) {
+        ComponentCacheEntry* newer = entry->newer;
+        BigNum_destroy(entry->count);
+        free(entry->key_v);
+        free(entry);
+        entry = newer;
+    }
+
+    free(cache->buckets_v);
+    free(cache);
+}
+
+const BigNum* ComponentCache_lookup(ComponentCache* cache, const uint32_t* key_v, unsigned int key_c) {
+    assert(cache != NULL);
+    assert(key_v != NULL);
+
+    uint64_t hash = ComponentCache_hash(key_v, key_c);
+    ComponentCacheEntry* entry = cache->buckets_v[hash & (cache->buckets_c - 1)];
+
+    for (; entry != NULL; entry = entry->bucket_next) {
+        if (entry->hash == hash && entry->key_c == key_c &&
+            memcmp(entry->key_v, key_v, key_c * sizeof(uint32_t)) == 0) {
+            // Mark as most recently used
+            ComponentCache_unlink(cache, entry);
+            ComponentCache_link_newest(cache, entry);
+
+            return entry->count;
+        }
+    }
+
+    return NULL;
+}
+
+void ComponentCache_store(ComponentCache* cache, const uint32_t* key_v, unsigned int key_c, const BigNum* count) {
+    assert(cache != NULL);
+    assert(key_v != NULL);
+    assert(count != NULL);
+
+    ComponentCacheEntry* entry = malloc(sizeof(ComponentCacheEntry));
+    assert(entry != NULL);
+
+    entry->hash = ComponentCache_hash(key_v, key_c);
+    entry->key_v = malloc(key_c * sizeof(uint32_t));
+    assert(entry->key_v != NULL);
+    memcpy(entry->key_v, key_v, key_c * sizeof(uint32_t));
+    entry->key_c = key_c;
+    entry->count = BigNum_copy(count);
+
+    // Entries that don't even fit into an empty cache are not stored
+    size_t memory = ComponentCache_entry_memory(entry);
+    if (memory > cache->memory_limit / 2) {
+        BigNum_destroy(entry->count);
+        free(entry->key_v);
+        free(entry);
+        return;
+    }
+
+    // Grow the buckets before evicting, so that their memory is kept
+    // within the limit as well
+    if (cache->entries_c >= cache->buckets_c) {
+        ComponentCache_grow(cache);
+    }
+
+    while (cache->memory + memory > cache->memory_limit && cache->oldest != NULL) {
+        ComponentCache_evict_oldest(cache);
+    }
+
+    unsigned int bucket = entry->hash & (cache->buckets_c - 1);
+    entry->bucket_next = cache->buckets_v[bucket];
+    cache->buckets_v[bucket] = entry;
+    ComponentCache_link_newest(cache, entry);
+
+    cache->memory += memory;
+    cache->entries_c++;
+}
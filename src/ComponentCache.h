@@ -0,0 +1,82 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+
+
+#ifndef COMPONENTCACHE_H
+#define COMPONENTCACHE_H
+
+
+#include "BigNum.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+/**
+ * A cached model count of a component, which is part of a hash bucket
+ * and of the list of entries ordered by last use.
+**/
+typedef struct ComponentCacheEntry {
+    uint64_t hash;
+    uint32_t* key_v;
+    unsigned int key_c;
+    BigNum* count;
+
+    struct ComponentCacheEntry* bucket_next;
+    struct ComponentCacheEntry* newer;
+    struct ComponentCacheEntry* older;
+} ComponentCacheEntry;
+
+/**
+ * Maps components of a Formula, given by a key that identifies their
+ * Variables and Clauses, to their number of models.
+ *
+ * Entries are found by a 64 bit hash of the key, the whole key is
+ * compared to rule out collisions. Once the memory used by entries and
+ * buckets exceeds the limit the least recently used entries are evicted.
+**/
+typedef struct {
+    ComponentCacheEntry** buckets_v;
+    unsigned int buckets_c;
+    unsigned int entries_c;
+
+    ComponentCacheEntry* newest;
+    ComponentCacheEntry* oldest;
+
+    size_t memory;
+    size_t memory_limit;
+} ComponentCache;
+
+
+ComponentCache* ComponentCache_create(size_t memory_limit);
+
+void ComponentCache_destroy(ComponentCache* cache);
+
+/**
+ * Returns the count stored for the key or NULL if there is none.
+ *
+ * The count belongs to the cache and is only valid until the next store.
+**/
+const BigNum* ComponentCache_lookup(ComponentCache* cache, const uint32_t* key_v, unsigned int key_c);
+
+/**
+ * Stores a copy of the key and the count.
+**/
+void ComponentCache_store(ComponentCache* cache, const uint32_t* key_v, unsigned int key_c, const BigNum* count);
+
+
+#endif
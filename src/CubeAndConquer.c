@@ -0,0 +1,443 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+#include "CubeAndConquer.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+// Number of Variables with the most occurrences that are looked ahead on
+// at every split
+#define CUBEANDCONQUER_CANDIDATES 16
+
+
+/**
+ * Cubes of indices of the cube list that still have to be solved.
+ *
+ * The owning thread takes cubes from the bottom, other threads steal
+ * from the top.
+**/
+typedef struct {
+    pthread_mutex_t lock;
+    unsigned int* cubes_v;
+    unsigned int top;
+    unsigned int bottom;
+} CubeDeque;
+
+/**
+ * A single thread solving cubes.
+**/
+typedef struct CubeWorker CubeWorker;
+
+/**
+ * State shared by the lookahead and all threads.
+**/
+typedef struct {
+    Formula* formula;
+
+    // All cubes stored back to back, cube i consists of the Literals from
+    // offsets_v[i] up to offsets_v[i + 1].
+    Literal* literals_v;
+    unsigned int literals_c;
+    unsigned int literals_capacity;
+    unsigned int* offsets_v;
+    unsigned int cubes_c;
+    unsigned int cubes_capacity;
+
+    // Copy of the Formula used for looking ahead along with the Literals
+    // assigned on the way to the current cube and the number of
+    // occurrences of every Variable.
+    Formula* lookahead;
+    Literal* path_v;
+    unsigned int path_c;
+    unsigned int* occurrences_c_v;
+
+    CubeWorker* workers_v;
+    unsigned int workers_c;
+
+    // Set by the first thread that finds a satisfiable cube
+    atomic_bool stop;
+    atomic_int winner;
+} CubeAndConquer;
+
+struct CubeWorker {
+    CubeAndConquer* cc;
+    unsigned int id;
+
+    pthread_t thread;
+    Formula* copy;
+    CubeDeque deque;
+};
+
+
+/**
+ * Stores the Literals on the path to the current node of the lookahead
+ * as a new cube.
+**/
+static void CubeAndConquer_add_cube(CubeAndConquer* cc) {
+    if (cc->cubes_c + 1 >= cc->cubes_capacity) {
+        cc->cubes_capacity *= 2;
+        cc->offsets_v = realloc(cc->offsets_v, cc->cubes_capacity * sizeof(unsigned int));
+        assert(cc->offsets_v != NULL);
+    }
+    while (cc->literals_c + cc->path_c > cc->literals_capacity) {
+        cc->literals_capacity *= 2;
+        cc->literals_v = realloc(cc->literals_v, cc->literals_capacity * sizeof(Literal));
+        assert(cc->literals_v != NULL);
+    }
+
+    memcpy(cc->literals_v + cc->literals_c, cc->path_v, cc->path_c * sizeof(Literal));
+    cc->literals_c += cc->path_c;
+    cc->cubes_c++;
+    cc->offsets_v[cc->cubes_c] = cc->literals_c;
+}
+
+/**
+ * Assigns the given Literal on a new decision level, records it on the
+ * path and propagates it.
+ *
+ * Returns false if this leads to a conflict.
+**/
+static bool CubeAndConquer_extend_path(CubeAndConquer* cc, Literal literal) {
+    Formula_decide(cc->lookahead, literal);
+    cc->path_v[cc->path_c++] = literal;
+
+    return Formula_unit_propagate(cc->lookahead) == CLAUSEREF_UNDEF;
+}
+
+/**
+ * Temporarily assigns the given Literal and counts the assignments its
+ * propagation leads to.
+ *
+ * Returns false if propagation leads to a conflict.
+**/
+static bool CubeAndConquer_probe(Formula* formula, Literal literal, unsigned int* assigned_c) {
+    unsigned int level = formula->decision_level;
+    unsigned int trail_c = formula->trail_c;
+
+    Formula_decide(formula, literal);
+    bool consistent = Formula_unit_propagate(formula) == CLAUSEREF_UNDEF;
+    *assigned_c = formula->trail_c - trail_c;
+    Formula_backtrack_to_level(formula, level);
+
+    return consistent;
+}
+
+/**
+ * Collects up to CUBEANDCONQUER_CANDIDATES unassigned Variables with the
+ * most occurrences, returns their number.
+**/
+static unsigned int CubeAndConquer_find_candidates(CubeAndConquer* cc, Variable* candidates_v) {
+    Formula* formula = cc->lookahead;
+    unsigned int candidates_c = 0;
+
+    for (Variable variable = 0; variable < formula->variables_c; variable++) {
+        if (formula->assignments_v[variable] != LiteralAssignment_UNSET) {
+            continue;
+        }
+
+        // Insert into the list sorted by occurrences, dropping the last
+        // Variable if the list is full
+        unsigned int occurrences_c = cc->occurrences_c_v[variable];
+        unsigned int i = candidates_c;
+        if (i == CUBEANDCONQUER_CANDIDATES) {
+            if (cc->occurrences_c_v[candidates_v[i - 1]] >= occurrences_c) {
+                continue;
+            }
+            i--;
+        } else {
+            candidates_c++;
+        }
+
+        while (i > 0 && cc->occurrences_c_v[candidates_v[i - 1]] < occurrences_c) {
+            candidates_v[i] = candidates_v[i - 1];
+            i--;
+        }
+        candidates_v[i] = variable;
+    }
+
+    return candidates_c;
+}
+
+/**
+ * Splits the current node of the lookahead into cubes until depth
+ * splits have been made.
+**/
+static void CubeAndConquer_split(CubeAndConquer* cc, unsigned int depth) {
+    Formula* formula = cc->lookahead;
+    unsigned int level = formula->decision_level;
+    unsigned int path_c = cc->path_c;
+
+    // Look ahead on all candidates and pick the one whose assignments
+    // propagate the most.
+    // Whenever one assignment of a candidate leads to a conflict the other
+    // one is forced, which may change the outcome for all other
+    // candidates, so they are evaluated again.
+    Variable candidates_v[CUBEANDCONQUER_CANDIDATES];
+    unsigned int candidates_c = 0;
+    Variable best = 0;
+    uint64_t best_score = 0;
+    bool forced = depth > 0;
+    bool refuted = false;
+
+    while (forced && !refuted) {
+        forced = false;
+        best_score = 0;
+        candidates_c = CubeAndConquer_find_candidates(cc, candidates_v);
+
+        for (unsigned int i = 0; i < candidates_c && !refuted; i++) {
+            Variable variable = candidates_v[i];
+            if (formula->assignments_v[variable] != LiteralAssignment_UNSET) {
+                continue;
+            }
+
+            Literal positive = Literal_create(variable, false);
+            unsigned int positive_c;
+            unsigned int negative_c;
+            bool positive_consistent = CubeAndConquer_probe(formula, positive, &positive_c);
+            bool negative_consistent = CubeAndConquer_probe(formula, Literal_negate(positive), &negative_c);
+
+            if (!positive_consistent && !negative_consistent) {
+                refuted = true;
+            } else if (!positive_consistent || !negative_consistent) {
+                Literal literal = positive_consistent ? positive : Literal_negate(positive);
+                refuted = !CubeAndConquer_extend_path(cc, literal);
+                forced = true;
+            } else {
+                uint64_t score = (uint64_t)(positive_c + 1) * (negative_c + 1);
+                if (score > best_score) {
+                    best_score = score;
+                    best = variable;
+                }
+            }
+        }
+    }
+
+    if (!refuted) {
+        if (depth == 0 || candidates_c == 0 || best_score == 0) {
+            CubeAndConquer_add_cube(cc);
+        } else {
+            // Split on both assignments of the best candidate
+            Literal literal = Literal_create(best, false);
+            for (unsigned int branch = 0; branch < 2; branch++) {
+                unsigned int branch_level = formula->decision_level;
+
+                if (CubeAndConquer_extend_path(cc, literal)) {
+                    CubeAndConquer_split(cc, depth - 1);
+                }
+
+                Formula_backtrack_to_level(formula, branch_level);
+                cc->path_c--;
+                literal = Literal_negate(literal);
+            }
+        }
+    }
+
+    Formula_backtrack_to_level(formula, level);
+    cc->path_c = path_c;
+}
+
+/**
+ * Splits the Formula into about cubes_c cubes.
+**/
+static void CubeAndConquer_create_cubes(CubeAndConquer* cc, unsigned int cubes_c) {
+    Formula* formula = cc->formula;
+
+    cc->literals_capacity = 64;
+    cc->literals_c = 0;
+    cc->literals_v = malloc(cc->literals_capacity * sizeof(Literal));
+    cc->cubes_capacity = 16;
+    cc->cubes_c = 0;
+    cc->offsets_v = malloc(cc->cubes_capacity * sizeof(unsigned int));
+    assert(cc->literals_v != NULL);
+    assert(cc->offsets_v != NULL);
+    cc->offsets_v[0] = 0;
+
+    if (formula->inconsistent) {
+        return;
+    }
+
+    cc->lookahead = Formula_copy(formula);
+    cc->lookahead->decision_heuristic = DecisionHeuristic_FIRST_UNSET;
+    cc->path_v = malloc(formula->variables_c * sizeof(Literal));
+    cc->path_c = 0;
+    cc->occurrences_c_v = calloc(formula->variables_c, sizeof(unsigned int));
+    assert(cc->path_v != NULL || formula->variables_c == 0);
+    assert(cc->occurrences_c_v != NULL || formula->variables_c == 0);
+
+    for (unsigned int i = 0; i < formula->clauses->size; i++) {
+        Clause* clause = ClauseArena_get(formula->arena, formula->clauses->data[i]);
+        for (unsigned int p = 0; p < clause->literals_c; p++) {
+            cc->occurrences_c_v[Literal_get_variable(clause->literals_v[p])]++;
+        }
+    }
+
+    // Each split at most doubles the number of cubes
+    unsigned int depth = 0;
+    while ((1u << depth) < cubes_c && depth < 31) {
+        depth++;
+    }
+
+    if (Formula_unit_propagate(cc->lookahead) == CLAUSEREF_UNDEF) {
+        CubeAndConquer_split(cc, depth);
+    }
+
+    free(cc->occurrences_c_v);
+    free(cc->path_v);
+    Formula_destroy(cc->lookahead);
+}
+
+/**
+ * Takes the next cube for the given thread, from its own deque or
+ * stolen from another thread.
+ *
+ * Returns false if there are no cubes left.
+**/
+static bool CubeAndConquer_take_cube(CubeAndConquer* cc, unsigned int id, unsigned int* cube) {
+    for (unsigned int i = 0; i < cc->workers_c; i++) {
+        CubeDeque* deque = &cc->workers_v[(id + i) % cc->workers_c].deque;
+        bool found = false;
+
+        pthread_mutex_lock(&deque->lock);
+        if (deque->top < deque->bottom) {
+            if (i == 0) {
+                *cube = deque->cubes_v[--deque->bottom];
+            } else {
+                *cube = deque->cubes_v[deque->top++];
+            }
+            found = true;
+        }
+        pthread_mutex_unlock(&deque->lock);
+
+        if (found) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Searches for a satisfying assignment below the Literals of a cube.
+ *
+ * Returns FALSE if the cube is refuted.
+**/
+static FormulaStatus CubeAndConquer_solve_cube(Formula* formula, const Literal* literals_v, unsigned int literals_c) {
+    Formula_set_assumptions(formula, literals_v, literals_c);
+    return Formula_dpll(formula);
+}
+
+static void* CubeAndConquer_run_worker(void* data) {
+    CubeWorker* worker = data;
+    CubeAndConquer* cc = worker->cc;
+
+    worker->copy = Formula_copy(cc->formula);
+    worker->copy->stop = &cc->stop;
+
+    // Refuted cubes don't need to be explained
+    worker->copy->collect_failed = false;
+
+    unsigned int cube;
+    while (!atomic_load_explicit(&cc->stop, memory_order_relaxed) &&
+           CubeAndConquer_take_cube(cc, worker->id, &cube)) {
+        FormulaStatus result = CubeAndConquer_solve_cube(worker->copy,
+                                                         cc->literals_v + cc->offsets_v[cube],
+                                                         cc->offsets_v[cube + 1] - cc->offsets_v[cube]);
+
+        // Stop all other threads if we are the first to satisfy the
+        // Formula
+        if (result == FormulaStatus_TRUE) {
+            int expected = -1;
+            if (atomic_compare_exchange_strong(&cc->winner, &expected, (int)worker->id)) {
+                atomic_store(&cc->stop, true);
+            }
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+FormulaStatus CubeAndConquer_solve(Formula* formula, unsigned int cubes_c, unsigned int threads_c) {
+    assert(formula != NULL);
+    assert(cubes_c > 0);
+    assert(threads_c > 0);
+
+    CubeAndConquer cc;
+    cc.formula = formula;
+    cc.workers_c = threads_c;
+    atomic_init(&cc.stop, false);
+    atomic_init(&cc.winner, -1);
+
+    CubeAndConquer_create_cubes(&cc, cubes_c);
+
+    // Hand out consecutive cubes to every thread, as neighbouring cubes
+    // share most of their assignments
+    cc.workers_v = malloc(threads_c * sizeof(CubeWorker));
+    assert(cc.workers_v != NULL);
+    for (unsigned int i = 0; i < threads_c; i++) {
+        CubeWorker* worker = &cc.workers_v[i];
+        unsigned int first = (uint64_t)cc.cubes_c * i / threads_c;
+        unsigned int last = (uint64_t)cc.cubes_c * (i + 1) / threads_c;
+
+        worker->cc = &cc;
+        worker->id = i;
+        worker->copy = NULL;
+
+        pthread_mutex_init(&worker->deque.lock, NULL);
+        worker->deque.cubes_v = malloc((last - first + 1) * sizeof(unsigned int));
+        assert(worker->deque.cubes_v != NULL);
+        worker->deque.top = 0;
+        worker->deque.bottom = 0;
+        for (unsigned int cube = last; cube > first; cube--) {
+            worker->deque.cubes_v[worker->deque.bottom++] = cube - 1;
+        }
+    }
+
+    for (unsigned int i = 0; i < threads_c; i++) {
+        int error = pthread_create(&cc.workers_v[i].thread, NULL, CubeAndConquer_run_worker, &cc.workers_v[i]);
+        assert(error == 0);
+        (void)error;
+    }
+    for (unsigned int i = 0; i < threads_c; i++) {
+        pthread_join(cc.workers_v[i].thread, NULL);
+    }
+
+    // Formula is unsatisfiable if all cubes were refuted
+    FormulaStatus result = FormulaStatus_FALSE;
+    int winner = atomic_load(&cc.winner);
+    if (winner >= 0) {
+        result = FormulaStatus_TRUE;
+        memcpy(formula->assignments_v,
+               cc.workers_v[winner].copy->assignments_v,
+               formula->variables_c * sizeof(LiteralAssignment));
+    }
+
+    for (unsigned int i = 0; i < threads_c; i++) {
+        Formula_destroy(cc.workers_v[i].copy);
+        free(cc.workers_v[i].deque.cubes_v);
+        pthread_mutex_destroy(&cc.workers_v[i].deque.lock);
+    }
+    free(cc.workers_v);
+    free(cc.literals_v);
+    free(cc.offsets_v);
+
+    return result;
+}
@@ -0,0 +1,43 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+#ifndef CUBEANDCONQUER_H
+#define CUBEANDCONQUER_H
+
+
+#include "Formula.h"
+
+
+/**
+ * Decides whether a Formula is satisfiable by splitting it into cubes
+ * and solving the cubes in parallel.
+ *
+ * A lookahead search splits the Formula up to a depth at which there are
+ * about cubes_c cubes (partial assignments). At every split the Variable
+ * whose assignments propagate the most is chosen and Literals whose
+ * negation propagates to a conflict are assigned right away, so that
+ * refuted branches never become cubes.
+ * The cubes are then solved with Formula_dpll by threads_c threads, each
+ * working on its own copy of the Formula. Every thread takes cubes from
+ * its own deque and steals from the deques of other threads once its own
+ * is empty. The first satisfiable cube stops all threads.
+ * If the Formula is satisfiable the satisfying assignment is stored in
+ * the given Formula.
+**/
+FormulaStatus CubeAndConquer_solve(Formula* formula, unsigned int cubes_c, unsigned int threads_c);
+
+
+#endif
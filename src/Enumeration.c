@@ -0,0 +1,69 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+
+
+#include "Enumeration.h"
+#include "Constants.h"
+
+#include <assert.h>
+#include <stdlib.h>
+
+
+/**
+ * State of a running enumeration.
+**/
+typedef struct {
+    unsigned long solutions_c;
+    unsigned long solutions_limit;
+    FILE* output;
+    BigNum* models;
+} Enumeration;
+
+
+static bool Enumeration_add_solution(void* data, Formula* formula) {
+    Enumeration* enumeration = data;
+
+    BigNum_add_power_of_two(enumeration->models, formula->variables_c - formula->trail_c);
+
+    if (enumeration->output != NULL) {
+        char* str = Formula_to_assignment_string(formula, false, CONSTANTS_COLOR_ENABLED);
+        fprintf(enumeration->output, "%s\n", str);
+        free(str);
+    }
+
+    enumeration->solutions_c++;
+    return enumeration->solutions_limit == 0 || enumeration->solutions_c < enumeration->solutions_limit;
+}
+
+FormulaStatus Enumeration_run(Formula* formula, unsigned long solutions_limit, FILE* output, BigNum* models) {
+    assert(formula != NULL);
+    assert(models != NULL);
+
+    Enumeration enumeration;
+    enumeration.solutions_c = 0;
+    enumeration.solutions_limit = solutions_limit;
+    enumeration.output = output;
+    enumeration.models = models;
+
+    formula->model = Enumeration_add_solution;
+    formula->model_data = &enumeration;
+    FormulaStatus result = Formula_dpll(formula);
+    formula->model = NULL;
+    formula->model_data = NULL;
+
+    return result;
+}
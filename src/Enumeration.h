@@ -0,0 +1,47 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+
+
+#ifndef ENUMERATION_H
+#define ENUMERATION_H
+
+
+#include "BigNum.h"
+#include "Formula.h"
+
+#include <stdio.h>
+
+
+/**
+ * Finds all satisfying assignments of a Formula in a single DPLL search,
+ * which backtracks chronologically after every one of them.
+ *
+ * Assignments may leave Variables unassigned whose value does not
+ * matter, each of them stands for 2^(number of unassigned Variables)
+ * models. If solutions_limit is not 0 the search stops after that many
+ * assignments. If output is not NULL every assignment is printed to it
+ * as one line containing only the assigned Variables.
+ * The number of models covered by the found assignments is added to
+ * models.
+ *
+ * Returns FALSE if all assignments were found, TRUE if the search
+ * stopped at the limit and UNDECIDED if it was stopped otherwise.
+**/
+FormulaStatus Enumeration_run(Formula* formula, unsigned long solutions_limit, FILE* output, BigNum* models);
+
+
+#endif
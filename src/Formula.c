@@ -23,31 +23,272 @@
 #include <string.h>
 
 
-Formula* Formula_create(LinkedList* clauses, GenericLiteral** all_literals_v, unsigned int all_literals_c) {
+// Factor by which activities decay with every conflict
+#define FORMULA_ACTIVITY_DECAY 0.95
+
+// Activities get rescaled when exceeding this limit
+#define FORMULA_ACTIVITY_LIMIT 1e100
+
+// Minimum number of learned Clauses kept before deleting any
+#define FORMULA_LEARNED_LIMIT_MIN 100
+
+// Factor by which the number of kept learned Clauses grows with every
+// deletion
+#define FORMULA_LEARNED_LIMIT_GROWTH 1.1
+
+// Fraction of wasted memory in the arena that triggers a compaction
+#define FORMULA_ARENA_WASTE_LIMIT 0.25
+
+// Number of conflicts between restarts is this multiplied by the Luby
+// sequence (1, 1, 2, 1, 1, 2, 4, ...)
+#define FORMULA_RESTART_INTERVAL 100
+
+
+static void Formula_attach_clause(Formula* formula, ClauseRef ref) {
+    Clause* clause = ClauseArena_get(formula->arena, ref);
+    bool* seen = formula->literal_marks_v;
+
+    // Remove duplicate Literals, otherwise the same Literal could be
+    // watched twice.
+    unsigned int filled = 0;
+    for (unsigned int i = 0; i < clause->literals_c; i++) {
+        Literal literal = clause->literals_v[i];
+
+        if (seen[literal]) {
+            continue;
+        }
+
+        seen[literal] = true;
+        clause->literals_v[filled++] = literal;
+    }
+    ClauseArena_shrink_clause(formula->arena, ref, filled);
+    for (unsigned int i = 0; i < clause->literals_c; i++) {
+        seen[clause->literals_v[i]] = false;
+    }
+
+    // Empty Clauses can never be satisfied
+    if (clause->literals_c == 0) {
+        formula->inconsistent = true;
+        clause->core = true;
+        return;
+    }
+
+    // One-Literal-Clauses are assigned right away
+    if (clause->literals_c == 1) {
+        Literal literal = clause->literals_v[0];
+
+        switch (Formula_get_assignment(formula, literal)) {
+            case LiteralAssignment_UNSET:
+                Formula_assign(formula, literal, ref);
+                break;
+            case LiteralAssignment_FALSE:
+                // Contradicts the One-Literal-Clause that assigned it
+                formula->inconsistent = true;
+                clause->core = true;
+                ClauseArena_get(formula->arena, formula->reasons_v[Literal_get_variable(literal)])->core = true;
+                break;
+            case LiteralAssignment_TRUE:
+                break;
+        }
+        return;
+    }
+
+    // Watch the first two Literals
+    ClauseRefVector_append(formula->watches_v[clause->literals_v[0]], ref);
+    ClauseRefVector_append(formula->watches_v[clause->literals_v[1]], ref);
+}
+
+Formula* Formula_create(ClauseArena* arena, ClauseRefVector* clauses, char** names_v, unsigned int variables_c) {
+    assert(arena != NULL);
     assert(clauses != NULL);
-    assert(all_literals_v != NULL);
+    assert(names_v != NULL || variables_c == 0);
 
     Formula* formula = malloc(sizeof(Formula));
     assert(formula != NULL);
 
+    formula->arena = arena;
     formula->clauses = clauses;
-    formula->all_literals_v = all_literals_v;
-    formula->all_literals_c = all_literals_c;
+    formula->names_v = names_v;
+    formula->name_table = NULL;
+    formula->variables_c = variables_c;
+    formula->owns_names = true;
+
+    // All Variables are unassigned
+    formula->assignments_v = malloc(variables_c * sizeof(LiteralAssignment));
+    assert(formula->assignments_v != NULL || variables_c == 0);
+    for (unsigned int i = 0; i < variables_c; i++) {
+        formula->assignments_v[i] = LiteralAssignment_UNSET;
+    }
+
+    // Create empty watch lists
+    formula->watches_v = malloc(2 * variables_c * sizeof(ClauseRefVector*));
+    assert(formula->watches_v != NULL || variables_c == 0);
+    for (unsigned int i = 0; i < 2 * variables_c; i++) {
+        formula->watches_v[i] = ClauseRefVector_create(4);
+    }
+
+    // Every Variable can be assigned at most once
+    formula->trail_v = malloc(variables_c * sizeof(Literal));
+    assert(formula->trail_v != NULL || variables_c == 0);
+    formula->trail_c = 0;
+    formula->propagation_head = 0;
+
+    // There can't be more decisions than Variables
+    formula->levels_capacity = variables_c;
+    formula->trail_lim_v = malloc(variables_c * sizeof(unsigned int));
+    formula->flipped_v = malloc(variables_c * sizeof(bool));
+    assert(formula->trail_lim_v != NULL || variables_c == 0);
+    assert(formula->flipped_v != NULL || variables_c == 0);
+    formula->decision_level = 0;
+
+    formula->levels_v = malloc(variables_c * sizeof(unsigned int));
+    formula->reasons_v = malloc(variables_c * sizeof(ClauseRef));
+    formula->seen_v = calloc(variables_c, sizeof(bool));
+    formula->learned_literals_v = malloc(variables_c * sizeof(Literal));
+    assert(formula->levels_v != NULL || variables_c == 0);
+    assert(formula->reasons_v != NULL || variables_c == 0);
+    assert(formula->seen_v != NULL || variables_c == 0);
+    assert(formula->learned_literals_v != NULL || variables_c == 0);
+    formula->literal_marks_v = calloc(2 * variables_c, sizeof(bool));
+    formula->clause_literals_v = malloc(variables_c * sizeof(Literal));
+    assert(formula->literal_marks_v != NULL || variables_c == 0);
+    assert(formula->clause_literals_v != NULL || variables_c == 0);
+    formula->level_stamps_v = calloc(variables_c + 1, sizeof(unsigned int));
+    assert(formula->level_stamps_v != NULL);
+    formula->level_stamp = 0;
+    formula->restart_conflicts_c = 0;
+    formula->restarts_c = 0;
+    formula->learned_clauses = ClauseRefVector_create(16);
+    formula->learned_limit = clauses->size / 3;
+    if (formula->learned_limit < FORMULA_LEARNED_LIMIT_MIN) {
+        formula->learned_limit = FORMULA_LEARNED_LIMIT_MIN;
+    }
+
+    formula->decision_heuristic = DecisionHeuristic_FIRST_UNSET;
+    formula->activity_heap = ActivityHeap_create(variables_c);
+    formula->activity_increment = 1.0;
+
+    formula->decision_phase = DecisionPhase_POSITIVE;
+    formula->phases_v = calloc(variables_c, sizeof(bool));
+    assert(formula->phases_v != NULL || variables_c == 0);
+    formula->random_state = 1;
+
+    formula->eliminated_v = calloc(variables_c, sizeof(bool));
+    assert(formula->eliminated_v != NULL || variables_c == 0);
+
+    formula->occurrences_v = NULL;
+    formula->true_clauses_c = 0;
+    formula->false_clauses_c = 0;
+
+    formula->assumptions_v = NULL;
+    formula->assumptions_c = 0;
+    formula->assumptions_capacity = 0;
+    formula->failed_v = NULL;
+    formula->failed_c = 0;
+    formula->collect_failed = true;
+    formula->collect_core = false;
+
+    formula->inconsistent = false;
+    formula->stop = NULL;
+    formula->terminate = NULL;
+    formula->terminate_data = NULL;
+    formula->learn = NULL;
+    formula->learn_data = NULL;
+    formula->model = NULL;
+    formula->model_data = NULL;
+    formula->exchange = NULL;
+    formula->split_queue = NULL;
+    formula->proof = NULL;
+
+    // Watch all Clauses
+    for (unsigned int i = 0; i < clauses->size; i++) {
+        Formula_attach_clause(formula, clauses->data[i]);
+    }
+
+    return formula;
+}
+
+Formula* Formula_create_named(ClauseArena* arena, ClauseRefVector* clauses, StringTable* name_table) {
+    assert(name_table != NULL);
+
+    Formula* formula = Formula_create(arena, clauses, name_table->strings_v, name_table->strings_c);
+    formula->name_table = name_table;
 
     return formula;
 }
 
+Formula* Formula_copy(Formula* formula) {
+    assert(formula != NULL);
+
+    // Copy all original Clauses into a new arena
+    ClauseArena* arena = ClauseArena_create(formula->arena->size);
+    ClauseRefVector* clauses = ClauseRefVector_create(formula->clauses->size);
+    for (unsigned int i = 0; i < formula->clauses->size; i++) {
+        Clause* clause = ClauseArena_get(formula->arena, formula->clauses->data[i]);
+        ClauseRefVector_append(clauses, ClauseArena_add(arena, clause->literals_v, clause->literals_c, false));
+    }
+
+    Formula* copy = Formula_create(arena, clauses, formula->names_v, formula->variables_c);
+    copy->name_table = formula->name_table;
+    copy->owns_names = false;
+    copy->decision_heuristic = formula->decision_heuristic;
+    copy->decision_phase = formula->decision_phase;
+    copy->collect_failed = formula->collect_failed;
+    for (Variable variable = 0; variable < formula->variables_c; variable++) {
+        copy->eliminated_v[variable] = formula->eliminated_v[variable];
+    }
+    Formula_set_assumptions(copy, formula->assumptions_v, formula->assumptions_c);
+
+    return copy;
+}
+
 void Formula_destroy(Formula* formula) {
     assert(formula != NULL);
 
     // Free all Clauses
-    LinkedList_destroy(formula->clauses, true);
+    ClauseRefVector_destroy(formula->clauses);
+    ClauseRefVector_destroy(formula->learned_clauses);
+    ClauseArena_destroy(formula->arena);
+
+    // Free watch lists and trail
+    for (unsigned int i = 0; i < 2 * formula->variables_c; i++) {
+        ClauseRefVector_destroy(formula->watches_v[i]);
+    }
+    free(formula->watches_v);
+    free(formula->trail_v);
+    free(formula->trail_lim_v);
+    free(formula->flipped_v);
+    free(formula->levels_v);
+    free(formula->reasons_v);
+    free(formula->seen_v);
+    free(formula->learned_literals_v);
+    free(formula->literal_marks_v);
+    free(formula->clause_literals_v);
+    free(formula->level_stamps_v);
+    free(formula->phases_v);
+    free(formula->eliminated_v);
+    free(formula->assumptions_v);
+    free(formula->failed_v);
+    ActivityHeap_destroy(formula->activity_heap);
+
+    // Free occurrence lists
+    if (formula->occurrences_v != NULL) {
+        for (unsigned int i = 0; i < 2 * formula->variables_c; i++) {
+            ClauseRefVector_destroy(formula->occurrences_v[i]);
+        }
+        free(formula->occurrences_v);
+    }
 
-    // Free all Literals
-    for (unsigned int i = 0; i < formula->all_literals_c; i++) {
-        GenericLiteral_destroy(formula->all_literals_v[i]);
+    // Free Variables
+    if (formula->owns_names && formula->name_table != NULL) {
+        StringTable_destroy(formula->name_table);
+    } else if (formula->owns_names) {
+        for (unsigned int i = 0; i < formula->variables_c; i++) {
+            free(formula->names_v[i]);
+        }
+        free(formula->names_v);
     }
-    free(formula->all_literals_v);
+    free(formula->assignments_v);
 
     // Free formula
     free(formula);
@@ -60,14 +301,15 @@ char* Formula_to_string(Formula* formula, bool color) {
     StringBuilder* builder = StringBuilder_create(10);
 
     // Add all Clauses contained in this Formula
-    for (LinkedListNode* iter = formula->clauses->head; iter != NULL; iter = iter->next) {
+    for (unsigned int i = 0; i < formula->clauses->size; i++) {
         // Add Clause
-        char* clause_str = Clause_to_string(iter->data, color);
+        Clause* clause = ClauseArena_get(formula->arena, formula->clauses->data[i]);
+        char* clause_str = Clause_to_string(clause, formula->names_v, formula->assignments_v, color);
         StringBuilder_append_string(builder, clause_str);
         free(clause_str);
 
         // Add delimiter between Clauses
-        if (iter->next != NULL) {
+        if (i != formula->clauses->size - 1) {
             StringBuilder_append_string(builder, CONSTANTS_CLAUSE_DELIMITER);
         }
     }
@@ -81,13 +323,13 @@ char* Formula_to_assignment_string(Formula* formula, bool print_all, bool color)
     // Create string
     StringBuilder* builder = StringBuilder_create(100);
 
-    // Add assignment string for all Literals
-    for (unsigned int i = 0; i < formula->all_literals_c; i++) {
-        GenericLiteral* literal = formula->all_literals_v[i];
+    // Add assignment string for all Variables
+    for (unsigned int i = 0; i < formula->variables_c; i++) {
+        LiteralAssignment assignment = formula->assignments_v[i];
 
-        if (print_all || GenericLiteral_get_assignment(literal) != LiteralAssignment_UNSET) {
-            // Add Literal assignment string
-            char* lit_str = GenericLiteral_to_assignment_string(literal, color);
+        if (print_all || assignment != LiteralAssignment_UNSET) {
+            // Add Variable assignment string
+            char* lit_str = Variable_to_assignment_string(formula->names_v[i], assignment, color);
             StringBuilder_append_string(builder, lit_str);
             free(lit_str);
 
@@ -99,101 +341,605 @@ char* Formula_to_assignment_string(Formula* formula, bool print_all, bool color)
     return StringBuilder_destroy_to_string(builder);
 }
 
-LiteralAssignmentArray* Formula_unit_propagate(Formula* formula) {
-    // If One-Literal-Clauses exists return their Literals,
-    // with the appropriate assignments.
+static inline void Formula_update_clause_status(Clause* clause) {
+    if (clause->true_c > 0) {
+        clause->clause_status = ClauseStatus_TRUE;
+    } else if (clause->false_c == clause->literals_c) {
+        clause->clause_status = ClauseStatus_FALSE;
+    } else {
+        clause->clause_status = ClauseStatus_UNDECIDED;
+    }
+}
 
-    unsigned int size = 3;
-    unsigned int filled = 0;
-    GenericLiteral** literals_v = malloc(size * sizeof(GenericLiteral*));
-    bool* assignments = malloc(size * sizeof(bool));
-    assert(literals_v != NULL);
-    assert(assignments != NULL);
-
-    for (LinkedListNode* iter = formula->clauses->head; iter != NULL; iter = iter->next) {
-        Clause* cl = iter->data;
-        if (cl->clause_status != ClauseStatus_UNDECIDED) {
-            continue;
+static void Formula_count_assignment(Formula* formula, Literal literal) {
+    // Clauses containing the Literal that became true
+    ClauseRefVector* occurrences = formula->occurrences_v[literal];
+    for (unsigned int i = 0; i < occurrences->size; i++) {
+        Clause* clause = ClauseArena_get(formula->arena, occurrences->data[i]);
+        if (clause->true_c++ == 0) {
+            if (clause->clause_status == ClauseStatus_FALSE) {
+                formula->false_clauses_c--;
+            }
+            formula->true_clauses_c++;
+            clause->clause_status = ClauseStatus_TRUE;
         }
+    }
 
-        Literal* only_literal = Clause_is_unit_clause(cl);
-        if (only_literal == NULL) {
-            continue;
+    // Clauses containing the Literal that became false
+    occurrences = formula->occurrences_v[Literal_negate(literal)];
+    for (unsigned int i = 0; i < occurrences->size; i++) {
+        Clause* clause = ClauseArena_get(formula->arena, occurrences->data[i]);
+        clause->false_c++;
+        if (clause->true_c == 0 && clause->false_c == clause->literals_c) {
+            formula->false_clauses_c++;
+            clause->clause_status = ClauseStatus_FALSE;
         }
+    }
+}
 
-        #if VERBOSE_DPLL
-            printf("  Unassigned Literal from One-Literal-Clause: %s\n",
-                   only_literal->generic_literal->name);
-        #endif
+static void Formula_count_unassignment(Formula* formula, Literal literal) {
+    // Clauses containing the Literal that was true
+    ClauseRefVector* occurrences = formula->occurrences_v[literal];
+    for (unsigned int i = 0; i < occurrences->size; i++) {
+        Clause* clause = ClauseArena_get(formula->arena, occurrences->data[i]);
+        if (--clause->true_c == 0) {
+            formula->true_clauses_c--;
+            Formula_update_clause_status(clause);
+            if (clause->clause_status == ClauseStatus_FALSE) {
+                formula->false_clauses_c++;
+            }
+        }
+    }
 
-        // Resize if necessary
-        if (filled + 1 > size) {
-            size = size * 2;
-            literals_v = realloc(literals_v, size * sizeof(Literal*));
-            assignments = realloc(assignments, size * sizeof(bool));
+    // Clauses containing the Literal that was false
+    occurrences = formula->occurrences_v[Literal_negate(literal)];
+    for (unsigned int i = 0; i < occurrences->size; i++) {
+        Clause* clause = ClauseArena_get(formula->arena, occurrences->data[i]);
+        if (clause->clause_status == ClauseStatus_FALSE) {
+            formula->false_clauses_c--;
         }
+        clause->false_c--;
+        Formula_update_clause_status(clause);
+    }
+}
 
-        // Add Literal and assignment to arrays
-        literals_v[filled] = only_literal->generic_literal;
-        if (only_literal->negated) {
-            assignments[filled] = false;
-        } else {
-            assignments[filled] = true;
+void Formula_track_clause_status(Formula* formula) {
+    assert(formula != NULL);
+
+    if (formula->occurrences_v != NULL) {
+        return;
+    }
+
+    // Create occurrence lists
+    formula->occurrences_v = malloc(2 * formula->variables_c * sizeof(ClauseRefVector*));
+    assert(formula->occurrences_v != NULL || formula->variables_c == 0);
+    for (unsigned int i = 0; i < 2 * formula->variables_c; i++) {
+        formula->occurrences_v[i] = ClauseRefVector_create(4);
+    }
+
+    // Count true and false Literals of every Clause once
+    formula->true_clauses_c = 0;
+    formula->false_clauses_c = 0;
+    for (unsigned int c = 0; c < formula->clauses->size; c++) {
+        ClauseRef ref = formula->clauses->data[c];
+        Clause* clause = ClauseArena_get(formula->arena, ref);
+        clause->true_c = 0;
+        clause->false_c = 0;
+
+        for (unsigned int i = 0; i < clause->literals_c; i++) {
+            Literal literal = clause->literals_v[i];
+            ClauseRefVector_append(formula->occurrences_v[literal], ref);
+
+            switch (Formula_get_assignment(formula, literal)) {
+                case LiteralAssignment_TRUE:
+                    clause->true_c++;
+                    break;
+                case LiteralAssignment_FALSE:
+                    clause->false_c++;
+                    break;
+                case LiteralAssignment_UNSET:
+                    break;
+            }
         }
-        filled++;
+
+        Formula_update_clause_status(clause);
+        if (clause->clause_status == ClauseStatus_TRUE) {
+            formula->true_clauses_c++;
+        } else if (clause->clause_status == ClauseStatus_FALSE) {
+            formula->false_clauses_c++;
+        }
+    }
+}
+
+/**
+ * Makes room for a decision level for every Variable and every
+ * assumption.
+**/
+static void Formula_grow_levels(Formula* formula) {
+    unsigned int levels_capacity = formula->variables_c + formula->assumptions_capacity;
+    if (levels_capacity <= formula->levels_capacity) {
+        return;
     }
 
-    // Shrink arrays to minimum size required
-    size = filled;
-    literals_v = realloc(literals_v, size * sizeof(Literal*));
-    assignments = realloc(assignments, size * sizeof(bool));
+    formula->trail_lim_v = realloc(formula->trail_lim_v, levels_capacity * sizeof(unsigned int));
+    formula->flipped_v = realloc(formula->flipped_v, levels_capacity * sizeof(bool));
+    formula->level_stamps_v = realloc(formula->level_stamps_v, (levels_capacity + 1) * sizeof(unsigned int));
+    assert(formula->trail_lim_v != NULL);
+    assert(formula->flipped_v != NULL);
+    assert(formula->level_stamps_v != NULL);
+
+    memset(formula->level_stamps_v + formula->levels_capacity + 1,
+           0,
+           (levels_capacity - formula->levels_capacity) * sizeof(unsigned int));
+    formula->levels_capacity = levels_capacity;
+}
+
+void Formula_add_variables(Formula* formula, unsigned int variables_c) {
+    assert(formula != NULL);
+    assert(formula->owns_names);
+    assert(formula->name_table == NULL);
+
+    unsigned int old_c = formula->variables_c;
+    if (variables_c <= old_c) {
+        return;
+    }
 
-    // If no appropriate Literals were found return false,
-    // otherwise return true;
-    if (filled == 0) {
-        free(literals_v);
-        free(assignments);
-        literals_v = NULL;
-        assignments = NULL;
-        return NULL;
+    formula->names_v = realloc(formula->names_v, variables_c * sizeof(char*));
+    formula->assignments_v = realloc(formula->assignments_v, variables_c * sizeof(LiteralAssignment));
+    formula->watches_v = realloc(formula->watches_v, 2 * variables_c * sizeof(ClauseRefVector*));
+    formula->trail_v = realloc(formula->trail_v, variables_c * sizeof(Literal));
+    formula->levels_v = realloc(formula->levels_v, variables_c * sizeof(unsigned int));
+    formula->reasons_v = realloc(formula->reasons_v, variables_c * sizeof(ClauseRef));
+    formula->seen_v = realloc(formula->seen_v, variables_c * sizeof(bool));
+    formula->learned_literals_v = realloc(formula->learned_literals_v, variables_c * sizeof(Literal));
+    formula->literal_marks_v = realloc(formula->literal_marks_v, 2 * variables_c * sizeof(bool));
+    formula->clause_literals_v = realloc(formula->clause_literals_v, variables_c * sizeof(Literal));
+    formula->phases_v = realloc(formula->phases_v, variables_c * sizeof(bool));
+    formula->eliminated_v = realloc(formula->eliminated_v, variables_c * sizeof(bool));
+    assert(formula->names_v != NULL);
+    assert(formula->assignments_v != NULL);
+    assert(formula->watches_v != NULL);
+    assert(formula->trail_v != NULL);
+    assert(formula->levels_v != NULL);
+    assert(formula->reasons_v != NULL);
+    assert(formula->seen_v != NULL);
+    assert(formula->learned_literals_v != NULL);
+    assert(formula->literal_marks_v != NULL);
+    assert(formula->clause_literals_v != NULL);
+    assert(formula->phases_v != NULL);
+    assert(formula->eliminated_v != NULL);
+
+    if (formula->occurrences_v != NULL) {
+        formula->occurrences_v = realloc(formula->occurrences_v, 2 * variables_c * sizeof(ClauseRefVector*));
+        assert(formula->occurrences_v != NULL);
     }
 
-    LiteralAssignmentArray* assignment_array;
-    assignment_array = LiteralAssignmentArray_create(literals_v,
-                                                     assignments,
-                                                     size);
+    for (Variable variable = old_c; variable < variables_c; variable++) {
+        // Name Variables like DIMACS does
+        char name[16];
+        snprintf(name, sizeof(name), "%u", variable + 1);
+        formula->names_v[variable] = strdup(name);
+        assert(formula->names_v[variable] != NULL);
+
+        formula->assignments_v[variable] = LiteralAssignment_UNSET;
+        formula->seen_v[variable] = false;
+        formula->literal_marks_v[Literal_create(variable, false)] = false;
+        formula->literal_marks_v[Literal_create(variable, true)] = false;
+        formula->phases_v[variable] = false;
+        formula->eliminated_v[variable] = false;
+        formula->reasons_v[variable] = CLAUSEREF_UNDEF;
+
+        for (unsigned int sign = 0; sign < 2; sign++) {
+            Literal literal = Literal_create(variable, sign);
+            formula->watches_v[literal] = ClauseRefVector_create(4);
+            if (formula->occurrences_v != NULL) {
+                formula->occurrences_v[literal] = ClauseRefVector_create(4);
+            }
+        }
+    }
 
-    return assignment_array;
+    formula->variables_c = variables_c;
+    ActivityHeap_grow(formula->activity_heap, variables_c);
+    Formula_grow_levels(formula);
 }
 
-LiteralAssignmentArray* Formula_choose_literal(Formula* formula) {
-    #if VERBOSE_DPLL
-    {
-        // Create a array of all unset Literals
-        LinkedList* unset_literals = LinkedList_create((void(*)(void*))GenericLiteral_destroy);
+void Formula_add_clause(Formula* formula, const Literal* literals_v, unsigned int literals_c) {
+    assert(formula != NULL);
+    assert(literals_v != NULL || literals_c == 0);
+
+    Formula_backtrack_to_level(formula, 0);
+
+    // Only keep Literals that are not false on decision level 0 and leave
+    // out duplicates. Clauses that are true on decision level 0 or contain
+    // a Literal and its negation are always true. The kept Literals belong
+    // to different Variables, so they fit into the buffer of the Formula.
+    // An empty Clause keeps no Literals and makes the Formula inconsistent
+    // once it is attached.
+    bool* seen = formula->literal_marks_v;
+    Literal* kept_literals = formula->clause_literals_v;
+    unsigned int kept_c = 0;
+    bool satisfied = false;
+    for (unsigned int i = 0; i < literals_c && !satisfied; i++) {
+        Literal literal = literals_v[i];
+        assert(Literal_get_variable(literal) < formula->variables_c);
+
+        switch (Formula_get_assignment(formula, literal)) {
+            case LiteralAssignment_TRUE:
+                satisfied = true;
+                break;
+            case LiteralAssignment_FALSE:
+                break;
+            case LiteralAssignment_UNSET:
+                if (seen[Literal_negate(literal)]) {
+                    satisfied = true;
+                } else if (!seen[literal]) {
+                    seen[literal] = true;
+                    kept_literals[kept_c++] = literal;
+                }
+                break;
+        }
+    }
+    for (unsigned int i = 0; i < kept_c; i++) {
+        seen[kept_literals[i]] = false;
+    }
+
+    if (!satisfied) {
+        ClauseRef ref = ClauseArena_add(formula->arena, kept_literals, kept_c, false);
+        ClauseRefVector_append(formula->clauses, ref);
+
+        // Keep status of Clause up to date, all its Literals are
+        // unassigned
+        if (formula->occurrences_v != NULL) {
+            Clause* clause = ClauseArena_get(formula->arena, ref);
+            clause->true_c = 0;
+            clause->false_c = 0;
+            for (unsigned int i = 0; i < clause->literals_c; i++) {
+                ClauseRefVector_append(formula->occurrences_v[clause->literals_v[i]], ref);
+            }
+
+            Formula_update_clause_status(clause);
+            if (clause->clause_status == ClauseStatus_FALSE) {
+                formula->false_clauses_c++;
+            }
+        }
+
+        Formula_attach_clause(formula, ref);
+    }
+}
+
+void Formula_replace_clauses(Formula* formula, ClauseArena* arena, ClauseRefVector* clauses) {
+    assert(formula != NULL);
+    assert(arena != NULL);
+    assert(clauses != NULL);
+    assert(formula->learned_clauses->size == 0);
+    assert(formula->occurrences_v == NULL);
+
+    // Remove the assignments of decision level 0 as well, they may come
+    // from Clauses that are replaced
+    Formula_backtrack_to_level(formula, 0);
+    Formula_backtrack(formula, 0);
+    for (unsigned int i = 0; i < 2 * formula->variables_c; i++) {
+        ClauseRefVector_shrink(formula->watches_v[i], 0);
+    }
+
+    ClauseRefVector_destroy(formula->clauses);
+    ClauseArena_destroy(formula->arena);
+    formula->arena = arena;
+    formula->clauses = clauses;
+    formula->inconsistent = false;
+
+    formula->learned_limit = clauses->size / 3;
+    if (formula->learned_limit < FORMULA_LEARNED_LIMIT_MIN) {
+        formula->learned_limit = FORMULA_LEARNED_LIMIT_MIN;
+    }
+
+    for (unsigned int i = 0; i < clauses->size; i++) {
+        Formula_attach_clause(formula, clauses->data[i]);
+    }
+}
+
+void Formula_set_assumptions(Formula* formula, const Literal* literals_v, unsigned int literals_c) {
+    assert(formula != NULL);
+    assert(literals_v != NULL || literals_c == 0);
+
+    if (literals_c > formula->assumptions_capacity) {
+        formula->assumptions_capacity = literals_c;
+        formula->assumptions_v = realloc(formula->assumptions_v, literals_c * sizeof(Literal));
+        formula->failed_v = realloc(formula->failed_v, literals_c * sizeof(Literal));
+        assert(formula->assumptions_v != NULL);
+        assert(formula->failed_v != NULL);
+        Formula_grow_levels(formula);
+    }
+
+    for (unsigned int i = 0; i < literals_c; i++) {
+        assert(Literal_get_variable(literals_v[i]) < formula->variables_c);
+        formula->assumptions_v[i] = literals_v[i];
+    }
+    formula->assumptions_c = literals_c;
+    formula->failed_c = 0;
+}
+
+bool Formula_find_variable(Formula* formula, const char* name, Variable* variable) {
+    assert(formula != NULL);
+    assert(name != NULL);
 
-        for (unsigned int i = 0; i < formula->all_literals_c; i++) {
-            GenericLiteral* lit = formula->all_literals_v[i];
+    if (formula->name_table != NULL) {
+        return StringTable_find(formula->name_table, name, strlen(name), variable);
+    }
+
+    // Variables are named by their number, which is one more than their
+    // index
+    char* end;
+    unsigned long number = strtoul(name, &end, 10);
+    if (name[0] < '0' || name[0] > '9' || *end != '\0' || number == 0 || number > formula->variables_c) {
+        return false;
+    }
+
+    // Numbers with leading zeros are not the name
+    if (strcmp(formula->names_v[number - 1], name) != 0) {
+        return false;
+    }
+
+    *variable = number - 1;
+    return true;
+}
+
+void Formula_assign(Formula* formula, Literal literal, ClauseRef reason) {
+    assert(formula != NULL);
+    assert(Formula_get_assignment(formula, literal) == LiteralAssignment_UNSET);
+    assert(formula->trail_c < formula->variables_c);
+
+    Variable variable = Literal_get_variable(literal);
+    formula->assignments_v[variable] = Literal_is_negated(literal) ? LiteralAssignment_FALSE : LiteralAssignment_TRUE;
+    formula->levels_v[variable] = formula->decision_level;
+    formula->reasons_v[variable] = reason;
+
+    // Remember the Literal that became true
+    formula->trail_v[formula->trail_c++] = literal;
+
+    if (formula->occurrences_v != NULL) {
+        Formula_count_assignment(formula, literal);
+    }
+}
+
+void Formula_backtrack(Formula* formula, unsigned int trail_mark) {
+    assert(formula != NULL);
+    assert(trail_mark <= formula->trail_c);
+
+    // Unassign in reverse order of assignment
+    while (formula->trail_c > trail_mark) {
+        formula->trail_c--;
+        Literal literal = formula->trail_v[formula->trail_c];
+        formula->assignments_v[Literal_get_variable(literal)] = LiteralAssignment_UNSET;
+        formula->phases_v[Literal_get_variable(literal)] = Literal_is_negated(literal);
+
+        if (formula->occurrences_v != NULL) {
+            Formula_count_unassignment(formula, literal);
+        }
+
+        // Variable can be chosen again
+        if (formula->decision_heuristic == DecisionHeuristic_VSIDS) {
+            ActivityHeap_insert(formula->activity_heap, Literal_get_variable(literal));
+        }
+    }
+
+    if (formula->propagation_head > trail_mark) {
+        formula->propagation_head = trail_mark;
+    }
+}
+
+/**
+ * Starts a new decision level without assigning anything yet.
+**/
+static void Formula_new_decision_level(Formula* formula) {
+    assert(formula->decision_level < formula->levels_capacity);
+
+    formula->trail_lim_v[formula->decision_level] = formula->trail_c;
+    formula->flipped_v[formula->decision_level] = false;
+    formula->decision_level++;
+}
+
+void Formula_decide(Formula* formula, Literal decision) {
+    assert(formula != NULL);
+
+    Formula_new_decision_level(formula);
+    Formula_assign(formula, decision, CLAUSEREF_UNDEF);
+}
+
+void Formula_backtrack_to_level(Formula* formula, unsigned int level) {
+    assert(formula != NULL);
+
+    if (level >= formula->decision_level) {
+        return;
+    }
+
+    Formula_backtrack(formula, formula->trail_lim_v[level]);
+    formula->decision_level = level;
+}
+
+ClauseRef Formula_unit_propagate(Formula* formula) {
+    assert(formula != NULL);
+
+    while (formula->propagation_head < formula->trail_c) {
+        // Only Clauses watching the Literal that just became false
+        // can have become One-Literal-Clauses or false.
+        Literal false_literal = Literal_negate(formula->trail_v[formula->propagation_head++]);
+
+        ClauseRefVector* watches = formula->watches_v[false_literal];
+        ClauseRef conflict = CLAUSEREF_UNDEF;
+        unsigned int kept = 0;
+        unsigned int i = 0;
+
+        while (i < watches->size) {
+            ClauseRef ref = watches->data[i++];
+            Clause* clause = ClauseArena_get(formula->arena, ref);
+            Literal* literals = clause->literals_v;
+
+            // Make sure the false Literal is the second watched Literal
+            if (literals[0] == false_literal) {
+                Literal tmp = literals[0];
+                literals[0] = literals[1];
+                literals[1] = tmp;
+            }
+
+            // If the other watched Literal is true the Clause is true
+            // and we can keep watching the false Literal.
+            if (Formula_get_assignment(formula, literals[0]) == LiteralAssignment_TRUE) {
+                watches->data[kept++] = ref;
+                continue;
+            }
+
+            // Try to find another Literal that is not false to watch instead
+            bool found_watch = false;
+            for (unsigned int p = 2; p < clause->literals_c; p++) {
+                if (Formula_get_assignment(formula, literals[p]) != LiteralAssignment_FALSE) {
+                    Literal tmp = literals[1];
+                    literals[1] = literals[p];
+                    literals[p] = tmp;
+
+                    ClauseRefVector_append(formula->watches_v[literals[1]], ref);
+                    found_watch = true;
+                    break;
+                }
+            }
+            if (found_watch) {
+                continue;
+            }
+
+            // All Literals except the other watched Literal are false
+            watches->data[kept++] = ref;
+
+            if (Formula_get_assignment(formula, literals[0]) == LiteralAssignment_FALSE) {
+                #if VERBOSE_DPLL
+                {
+                    char* clause_str = Clause_to_string(clause, formula->names_v, formula->assignments_v, CONSTANTS_COLOR_ENABLED);
+                    printf("  Clause %s is false, going back ...\n", clause_str);
+                    free(clause_str);
+                }
+                #endif
+
+                conflict = ref;
+                break;
+            }
+
+            #if VERBOSE_DPLL
+                printf("  Unassigned Literal from One-Literal-Clause: %s\n",
+                       formula->names_v[Literal_get_variable(literals[0])]);
+            #endif
+
+            Formula_assign(formula, literals[0], ref);
+        }
+
+        // Keep remaining watches if we stopped early
+        while (i < watches->size) {
+            watches->data[kept++] = watches->data[i++];
+        }
+        ClauseRefVector_shrink(watches, kept);
+
+        if (conflict != CLAUSEREF_UNDEF) {
+            formula->propagation_head = formula->trail_c;
+            return conflict;
+        }
+    }
+
+    return CLAUSEREF_UNDEF;
+}
+
+static void Formula_bump_activity(Formula* formula, Variable variable) {
+    double activity = ActivityHeap_bump(formula->activity_heap,
+                                        variable,
+                                        formula->activity_increment);
+
+    // Keep activities in range, this doesn't change their order
+    if (activity > FORMULA_ACTIVITY_LIMIT) {
+        ActivityHeap_rescale(formula->activity_heap, 1.0 / FORMULA_ACTIVITY_LIMIT);
+        formula->activity_increment /= FORMULA_ACTIVITY_LIMIT;
+    }
+}
+
+static void Formula_decay_activities(Formula* formula) {
+    // Instead of decreasing all activities we increase the amount
+    // future bumps add.
+    formula->activity_increment /= FORMULA_ACTIVITY_DECAY;
+}
+
+static void Formula_bump_conflict(Formula* formula, ClauseRef conflict_ref) {
+    Clause* conflict = ClauseArena_get(formula->arena, conflict_ref);
 
-            if (GenericLiteral_get_assignment(lit) == LiteralAssignment_UNSET) {
-                LinkedList_prepend(unset_literals, lit);
+    // Bump all Variables of the false Clause and of the One-Literal-Clauses
+    // that implied their assignments.
+    for (unsigned int i = 0; i < conflict->literals_c; i++) {
+        Variable variable = Literal_get_variable(conflict->literals_v[i]);
+        Formula_bump_activity(formula, variable);
+
+        if (formula->reasons_v[variable] == CLAUSEREF_UNDEF) {
+            continue;
+        }
+        Clause* reason = ClauseArena_get(formula->arena, formula->reasons_v[variable]);
+        for (unsigned int p = 0; p < reason->literals_c; p++) {
+            if (Literal_get_variable(reason->literals_v[p]) != variable) {
+                Formula_bump_activity(formula, Literal_get_variable(reason->literals_v[p]));
             }
         }
+    }
+
+    Formula_decay_activities(formula);
+}
+
+static unsigned int Formula_random(Formula* formula) {
+    // xorshift32
+    unsigned int x = formula->random_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    formula->random_state = x;
+
+    return x;
+}
+
+void Formula_set_seed(Formula* formula, unsigned int seed) {
+    assert(formula != NULL);
+
+    // State of xorshift must not be 0
+    formula->random_state = (seed == 0) ? 1 : seed;
+
+    // Activities are bumped by at least 1, so this only breaks ties
+    // until the first conflicts.
+    for (Variable variable = 0; variable < formula->variables_c; variable++) {
+        double amount = (Formula_random(formula) % 1000) * 1e-6;
+        ActivityHeap_bump(formula->activity_heap, variable, amount);
+    }
+}
+
+static Literal Formula_choose_phase(Formula* formula, Variable variable) {
+    switch (formula->decision_phase) {
+        case DecisionPhase_NEGATIVE:
+            return Literal_create(variable, true);
+        case DecisionPhase_SAVED:
+            return Literal_create(variable, formula->phases_v[variable]);
+        case DecisionPhase_RANDOM:
+            return Literal_create(variable, Formula_random(formula) & 1);
+        case DecisionPhase_POSITIVE:
+        default:
+            return Literal_create(variable, false);
+    }
+}
 
-        // Print all literals (set and unset)
+bool Formula_choose_literal(Formula* formula, Literal* decision) {
+    #if VERBOSE_DPLL
+    {
+        // Print all Variables (set and unset)
         {
             // Create string
             StringBuilder* builder = StringBuilder_create(100);
             StringBuilder_append_string(builder, "All literals: (");
 
-            for (unsigned int i = 0; i < formula->all_literals_c; i++) {
-                // Add name of Literal
-                GenericLiteral* literal = formula->all_literals_v[i];
-                char* lit_str = literal->name;
-                StringBuilder_append_string(builder, lit_str);
+            for (unsigned int i = 0; i < formula->variables_c; i++) {
+                // Add name of Variable
+                StringBuilder_append_string(builder, formula->names_v[i]);
 
                 // Add separator char
-                if (i != formula->all_literals_c - 1) {
+                if (i != formula->variables_c - 1) {
                     StringBuilder_append_char(builder, ',');
                 }
             }
@@ -203,62 +949,69 @@ LiteralAssignmentArray* Formula_choose_literal(Formula* formula) {
             free(str);
         }
 
-        // Print all unset Literals
+        // Print all unset Variables
         {
             // Create string
             StringBuilder* builder = StringBuilder_create(100);
             StringBuilder_append_string(builder, "Available literals: (");
 
-            int i = 0;
-            for (LinkedListNode* iter = unset_literals->head; iter != NULL; iter = iter->next) {
-                // Add name of Literal
-                GenericLiteral* literal = iter->data;
-                char* lit_str = literal->name;
-                StringBuilder_append_string(builder, lit_str);
+            bool first = true;
+            for (unsigned int i = 0; i < formula->variables_c; i++) {
+                if (formula->assignments_v[i] != LiteralAssignment_UNSET) {
+                    continue;
+                }
 
                 // Add separator char
-                if (i != unset_literals->size - 1) {
+                if (!first) {
                     StringBuilder_append_char(builder, ',');
                 }
+                first = false;
 
-                i++;
+                // Add name of Variable
+                StringBuilder_append_string(builder, formula->names_v[i]);
             }
 
             char* str = StringBuilder_destroy_to_string(builder);
             printf("  %s)\n", str);
             free(str);
         }
-
-        // Free list of unset Literals
-        LinkedList_destroy(unset_literals, false);
     }
     #endif
 
-    // Just return the first available (unset) Literal
-    for (unsigned int i = 0; i < formula->all_literals_c; i++) {
-        GenericLiteral* lit = formula->all_literals_v[i];
+    // Return the most active unset Variable.
+    // Assigned Variables are removed from the heap only when they reach
+    // the top and get reinserted when they are unassigned.
+    if (formula->decision_heuristic == DecisionHeuristic_VSIDS) {
+        while (!ActivityHeap_is_empty(formula->activity_heap)) {
+            Variable variable = ActivityHeap_pop(formula->activity_heap);
 
-        if (GenericLiteral_get_assignment(lit) == LiteralAssignment_UNSET) {
-            #if VERBOSE_DPLL
-                printf("  Picked unassigned literal: %s\n", lit->name);
-            #endif
+            if (formula->assignments_v[variable] == LiteralAssignment_UNSET && !formula->eliminated_v[variable]) {
+                #if VERBOSE_DPLL
+                    printf("  Picked most active literal: %s\n", formula->names_v[variable]);
+                #endif
 
-            GenericLiteral** literals = malloc(1 * sizeof(GenericLiteral*));
-            assert(literals != NULL);
-            literals[0] = lit;
+                *decision = Formula_choose_phase(formula, variable);
+                return true;
+            }
+        }
+
+        return false;
+    }
 
-            bool* assignment = malloc(sizeof(bool));
-            assert(assignment != NULL);
-            *assignment = true;
+    // Just return the first available (unset) Variable
+    for (Variable variable = 0; variable < formula->variables_c; variable++) {
+        if (formula->assignments_v[variable] == LiteralAssignment_UNSET && !formula->eliminated_v[variable]) {
+            #if VERBOSE_DPLL
+                printf("  Picked unassigned literal: %s\n", formula->names_v[variable]);
+            #endif
 
-            LiteralAssignmentArray* array;
-            array = LiteralAssignmentArray_create(literals, assignment, 1);
-            return array;
+            *decision = Formula_choose_phase(formula, variable);
+            return true;
         }
     }
 
     // No literal left
-    return NULL;
+    return false;
 }
 
 FormulaStatus Formula_evaluate(Formula* formula) {
@@ -267,17 +1020,32 @@ FormulaStatus Formula_evaluate(Formula* formula) {
         printf("  evaluating ...\n");
     #endif
 
+    // Use counts if Clause status is tracked
+    if (formula->occurrences_v != NULL) {
+        if (formula->false_clauses_c > 0) {
+            return FormulaStatus_FALSE;
+        }
+        if (formula->true_clauses_c == formula->clauses->size) {
+            #if VERBOSE_DPLL
+                printf("  All Clauses true -> formula satisfied\n");
+            #endif
+
+            return FormulaStatus_TRUE;
+        }
+        return FormulaStatus_UNDECIDED;
+    }
+
     bool all_clauses_assigned = true;
 
-    for (LinkedListNode* iter = formula->clauses->head; iter != NULL; iter = iter->next) {
-        Clause* clause = iter->data;
-        ClauseStatus status = Clause_evaluate(clause);
+    for (unsigned int i = 0; i < formula->clauses->size; i++) {
+        Clause* clause = ClauseArena_get(formula->arena, formula->clauses->data[i]);
+        ClauseStatus status = Clause_evaluate(clause, formula->assignments_v);
 
         switch(status) {
             case ClauseStatus_TRUE:
                 #if VERBOSE_DPLL
                 {
-                    char* clause_str = Clause_to_string(clause, CONSTANTS_COLOR_ENABLED);
+                    char* clause_str = Clause_to_string(clause, formula->names_v, formula->assignments_v, CONSTANTS_COLOR_ENABLED);
                     printf("  Clause %s is true ...\n", clause_str);
                     free(clause_str);
                 }
@@ -286,7 +1054,7 @@ FormulaStatus Formula_evaluate(Formula* formula) {
             case ClauseStatus_FALSE:
                 #if VERBOSE_DPLL
                 {
-                    char* clause_str = Clause_to_string(clause, CONSTANTS_COLOR_ENABLED);
+                    char* clause_str = Clause_to_string(clause, formula->names_v, formula->assignments_v, CONSTANTS_COLOR_ENABLED);
                     printf("  Clause %s is false, going back ...\n", clause_str);
                     free(clause_str);
                 }
@@ -328,97 +1096,858 @@ FormulaStatus Formula_evaluate(Formula* formula) {
     return FormulaStatus_UNDECIDED;
 }
 
-bool Formula_dpll(Formula* formula) {
-    #if VERBOSE_DPLL
-    {
-        char* formula_str = Formula_to_string(formula, CONSTANTS_COLOR_ENABLED);
-        char* formula_assign_str = Formula_to_assignment_string(formula, false, CONSTANTS_COLOR_ENABLED);
+static inline bool Formula_is_stopped(Formula* formula) {
+    if (formula->stop != NULL && atomic_load_explicit(formula->stop, memory_order_relaxed)) {
+        return true;
+    }
 
-        printf("\n\n\n");
-        printf("Formula:\t%s\n", formula_str);
-        printf("Assignments:\t%s\n", formula_assign_str);
+    return formula->terminate != NULL && formula->terminate(formula->terminate_data);
+}
 
-        free(formula_str);
-        free(formula_assign_str);
+/**
+ * Marks the Variable of an assigned Literal for Formula_analyze_final.
+ *
+ * Assumptions are added to failed_v right away and stay marked, so that
+ * they are only added once. Returns whether the Variable still has to be
+ * followed backwards.
+**/
+static bool Formula_mark_final(Formula* formula, Literal literal) {
+    Variable variable = Literal_get_variable(literal);
+    unsigned int level = formula->levels_v[variable];
+    if (formula->seen_v[variable] || level == 0) {
+        return false;
     }
-    #endif
+    formula->seen_v[variable] = true;
 
-    // Evaluate Formula
-    FormulaStatus status = Formula_evaluate(formula);
-    if (status == FormulaStatus_TRUE) {
-        return true;
-    } else if (status == FormulaStatus_FALSE) {
+    // Every assumption has its own decision level at the bottom
+    if (formula->reasons_v[variable] == CLAUSEREF_UNDEF && level <= formula->assumptions_c) {
+        formula->failed_v[formula->failed_c++] = formula->assumptions_v[level - 1];
         return false;
     }
 
-    // Try to find another another Literal which hasn't been
-    // assigned a value.
-    //
-    // Normally we first try to assign true to Literals, but sometimes
-    // (a negated Literal in a One-Literal-Clause) it's smarter to
-    // assign false first.
-    LiteralAssignmentArray* assignment_array;
-    assignment_array = Formula_unit_propagate(formula);
+    return true;
+}
 
-    if (assignment_array == NULL) {
-        assignment_array = Formula_choose_literal(formula);
+/**
+ * Adds the assumptions that lead to the assignments of the given Literals
+ * to failed_v by following the implication graph backwards from them.
+ *
+ * Decisions that are not assumptions end the walk, if they are flipped
+ * the assumptions involved in refuting their other branch have been
+ * added before. Until Formula_clear_final the Variables of all failed
+ * assumptions are kept marked.
+**/
+static void Formula_analyze_final(Formula* formula, const Literal* literals_v, unsigned int literals_c) {
+    unsigned int pending_c = 0;
+    for (unsigned int i = 0; i < literals_c; i++) {
+        pending_c += Formula_mark_final(formula, literals_v[i]);
     }
 
-    // If we don't find one it means every Literal has a value
-    // in the current assignment, but the it doesn't make the Formula
-    // true.
-    // So we return false and try another assignment (or fail).
-    if (assignment_array == NULL) {
-        #if VERBOSE_DPLL
-            printf("  Found no unassigned literal\n");
-        #endif
+    for (unsigned int i = formula->trail_c; pending_c > 0; i--) {
+        Variable variable = Literal_get_variable(formula->trail_v[i - 1]);
+        ClauseRef reason = formula->reasons_v[variable];
+        if (!formula->seen_v[variable] ||
+            (reason == CLAUSEREF_UNDEF && formula->levels_v[variable] <= formula->assumptions_c)) {
+            continue;
+        }
+        formula->seen_v[variable] = false;
+        pending_c--;
+
+        if (reason == CLAUSEREF_UNDEF) {
+            continue;
+        }
+
+        Clause* clause = ClauseArena_get(formula->arena, reason);
+        for (unsigned int p = 0; p < clause->literals_c; p++) {
+            if (Literal_get_variable(clause->literals_v[p]) != variable) {
+                pending_c += Formula_mark_final(formula, clause->literals_v[p]);
+            }
+        }
+    }
+}
+
+/**
+ * Marks the Clauses that lead to a conflict as part of the unsatisfiable
+ * core by following the implication graph backwards from the conflicting
+ * Clause to the decisions.
+ *
+ * Clauses learned by CDCL are marked along with the others, the Clauses
+ * they were derived from were marked when they were learned.
+**/
+static void Formula_mark_core(Formula* formula, ClauseRef conflict) {
+    assert(formula->assumptions_c == 0);
+
+    Clause* clause = ClauseArena_get(formula->arena, conflict);
+    clause->core = true;
+
+    unsigned int pending_c = 0;
+    for (unsigned int p = 0; p < clause->literals_c; p++) {
+        Variable variable = Literal_get_variable(clause->literals_v[p]);
+        if (!formula->seen_v[variable]) {
+            formula->seen_v[variable] = true;
+            pending_c++;
+        }
+    }
+
+    for (unsigned int i = formula->trail_c; pending_c > 0; i--) {
+        Variable variable = Literal_get_variable(formula->trail_v[i - 1]);
+        if (!formula->seen_v[variable]) {
+            continue;
+        }
+        formula->seen_v[variable] = false;
+        pending_c--;
+
+        ClauseRef reason = formula->reasons_v[variable];
+        if (reason == CLAUSEREF_UNDEF) {
+            continue;
+        }
+
+        Clause* reason_clause = ClauseArena_get(formula->arena, reason);
+        reason_clause->core = true;
+        for (unsigned int p = 0; p < reason_clause->literals_c; p++) {
+            Variable other = Literal_get_variable(reason_clause->literals_v[p]);
+            if (other != variable && !formula->seen_v[other]) {
+                formula->seen_v[other] = true;
+                pending_c++;
+            }
+        }
+    }
+}
+
+/**
+ * Removes the marks Formula_analyze_final left on failed assumptions.
+**/
+static void Formula_clear_final(Formula* formula) {
+    for (unsigned int i = 0; i < formula->failed_c; i++) {
+        formula->seen_v[Literal_get_variable(formula->failed_v[i])] = false;
+    }
+}
+
+/**
+ * Makes the next assumption that is not true yet the next decision.
+ * Assumptions that are true already get an empty decision level, so that
+ * the decision level still tells how many assumptions were made. The
+ * other branch of assumptions is never tried.
+ *
+ * Returns false if an assumption is false, in which case failed_v
+ * contains it along with the assumptions that lead to this.
+**/
+static bool Formula_make_assumption(Formula* formula, bool* assumed) {
+    *assumed = false;
+
+    while (formula->decision_level < formula->assumptions_c) {
+        Literal assumption = formula->assumptions_v[formula->decision_level];
+
+        switch (Formula_get_assignment(formula, assumption)) {
+            case LiteralAssignment_TRUE:
+                Formula_new_decision_level(formula);
+                break;
+            case LiteralAssignment_FALSE:
+                formula->failed_v[formula->failed_c++] = assumption;
+                Formula_analyze_final(formula, &assumption, 1);
+                return false;
+            case LiteralAssignment_UNSET:
+                Formula_decide(formula, assumption);
+                *assumed = true;
+                break;
+        }
+        formula->flipped_v[formula->decision_level - 1] = true;
+
+        if (*assumed) {
+            return true;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Gives away the other branch of the earliest decision whose other branch
+ * has not been tried yet, along with all decisions before it.
+**/
+static void Formula_split(Formula* formula) {
+    unsigned int level = 0;
+    while (level < formula->decision_level && formula->flipped_v[level]) {
+        level++;
+    }
+    if (level == formula->decision_level) {
+        return;
+    }
+
+    // Levels of assumptions that were true already are empty and left out
+    Literal* literals = formula->learned_literals_v;
+    unsigned int literals_c = 0;
+    for (unsigned int i = 0; i < level; i++) {
+        unsigned int mark = formula->trail_lim_v[i];
+        if (mark < formula->trail_c && formula->levels_v[Literal_get_variable(formula->trail_v[mark])] == i + 1) {
+            literals[literals_c++] = formula->trail_v[mark];
+        }
+    }
+    literals[literals_c++] = Literal_negate(formula->trail_v[formula->trail_lim_v[level]]);
+
+    #if VERBOSE_DPLL
+        printf("  Giving away other branch of decision on level %u\n", level);
+    #endif
+
+    SplitQueue_push(formula->split_queue, literals, literals_c);
+    formula->flipped_v[level] = true;
+}
+
+/**
+ * Writes the Clause that the decisions of all current decision levels
+ * can't be true at once to the proof.
+ *
+ * If the current assignment is in conflict this follows by unit
+ * propagation, as it does once both branches of the next decision are
+ * refuted.
+**/
+static void Formula_prove_decisions(Formula* formula) {
+    unsigned int literals_c = 0;
+    for (unsigned int level = 0; level < formula->decision_level; level++) {
+        // Levels of assumptions that were already true are empty
+        unsigned int end = (level + 1 < formula->decision_level) ? formula->trail_lim_v[level + 1] : formula->trail_c;
+        if (formula->trail_lim_v[level] < end) {
+            formula->learned_literals_v[literals_c++] = Literal_negate(formula->trail_v[formula->trail_lim_v[level]]);
+        }
+    }
+
+    Proof_add(formula->proof, formula->learned_literals_v, literals_c);
+}
+
+/**
+ * Goes back to the most recent decision whose other branch has not been
+ * tried yet and tries it.
+ *
+ * Returns false if there is no such decision.
+**/
+static bool Formula_flip_last_decision(Formula* formula) {
+    while (formula->decision_level > 0 &&
+           formula->flipped_v[formula->decision_level - 1]) {
+        Formula_backtrack_to_level(formula, formula->decision_level - 1);
+
+        // Both branches of the decision are refuted, so are the decisions
+        // before it
+        if (formula->proof != NULL) {
+            Formula_prove_decisions(formula);
+        }
+    }
+
+    if (formula->decision_level == 0) {
         return false;
     }
 
-    // Set the found Literal to the preferred assignment and rerun
-    // the algorithm.
-    for (unsigned int i = 0; i < 2; i++) {
-        // Set selected Literal to selected assignment
-        for (unsigned int p = 0; p < assignment_array->size; p++) {
-            GenericLiteral* lit = assignment_array->literals[p];
-            bool assignment = assignment_array->assignments[p];
+    // Restore the state of assignment from before the decision, but keep
+    // its decision level and set the Literal to the non-preferred
+    // assignment.
+    unsigned int level = formula->decision_level - 1;
+    Literal decision = formula->trail_v[formula->trail_lim_v[level]];
+    Formula_backtrack(formula, formula->trail_lim_v[level]);
+    formula->flipped_v[level] = true;
+
+    #if VERBOSE_DPLL
+        printf("  Trying %s=%s\n",
+               formula->names_v[Literal_get_variable(decision)],
+               Literal_is_negated(decision) ? "true" : "false");
+    #endif
+
+    Formula_assign(formula, Literal_negate(decision), CLAUSEREF_UNDEF);
+    return true;
+}
+
+/**
+ * Chooses a Literal of the first Clause that is neither true nor false,
+ * so that Variables not needed to make the Formula true stay unassigned.
+ * Needs the status of Clauses to be tracked.
+ *
+ * Returns false if there is no such Clause.
+**/
+static bool Formula_choose_literal_of_open_clause(Formula* formula, Literal* decision) {
+    for (unsigned int i = 0; i < formula->clauses->size; i++) {
+        Clause* clause = ClauseArena_get(formula->arena, formula->clauses->data[i]);
+        if (clause->clause_status != ClauseStatus_UNDECIDED) {
+            continue;
+        }
 
-            GenericLiteral_assign(lit, assignment);
+        for (unsigned int p = 0; p < clause->literals_c; p++) {
+            if (Formula_get_assignment(formula, clause->literals_v[p]) == LiteralAssignment_UNSET) {
+                *decision = clause->literals_v[p];
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+FormulaStatus Formula_dpll(Formula* formula) {
+    // Start over if the Formula was searched before
+    Formula_backtrack_to_level(formula, 0);
+    formula->failed_c = 0;
+
+    // Formula contains an empty Clause or contradicting One-Literal-Clauses
+    if (formula->inconsistent) {
+        if (formula->proof != NULL) {
+            Proof_add(formula->proof, NULL, 0);
+        }
+        return FormulaStatus_FALSE;
+    }
+
+    // Keep track of true Clauses so that we notice when the Formula
+    // became true before every Literal is assigned.
+    Formula_track_clause_status(formula);
+
+    FormulaStatus result = FormulaStatus_UNDECIDED;
+    while (true) {
+        if (Formula_is_stopped(formula)) {
+            break;
+        }
+
+        // Assign Literals from One-Literal-Clauses until there are no more
+        // One-Literal-Clauses.
+        ClauseRef conflict = Formula_unit_propagate(formula);
+
+        if (conflict != CLAUSEREF_UNDEF) {
+            if (formula->decision_heuristic == DecisionHeuristic_VSIDS) {
+                Formula_bump_conflict(formula, conflict);
+            }
+
+            // A conflict without any decisions can't be found again by
+            // later searches
+            if (formula->decision_level == 0) {
+                formula->inconsistent = true;
+            }
+
+            if (formula->proof != NULL) {
+                Formula_prove_decisions(formula);
+            }
+            if (formula->collect_core) {
+                Formula_mark_core(formula, conflict);
+            }
+
+            // Remember the assumptions this conflict depends on
+            if (formula->assumptions_c > 0 && formula->collect_failed) {
+                Clause* clause = ClauseArena_get(formula->arena, conflict);
+                Formula_analyze_final(formula, clause->literals_v, clause->literals_c);
+            }
+
+            // Go back to the most recent decision of which we haven't
+            // tried the non-preferred assignment yet. If there is no such
+            // decision the Formula is unsatisfiable (under the
+            // assumptions).
+            if (!Formula_flip_last_decision(formula)) {
+                result = FormulaStatus_FALSE;
+                break;
+            }
+            continue;
         }
 
         #if VERBOSE_DPLL
-            for (int p = 0; p < assignment_array->size; p++) {
-                GenericLiteral* lit = assignment_array->literals[p];
-                char* assignment_str = NULL;
-                assignment_str = GenericLiteral_to_assignment_string(lit, CONSTANTS_COLOR_ENABLED);
-                printf("  Trying %s\n", assignment_str);
-                free(assignment_str);
+        {
+            char* formula_str = Formula_to_string(formula, CONSTANTS_COLOR_ENABLED);
+            char* formula_assign_str = Formula_to_assignment_string(formula, false, CONSTANTS_COLOR_ENABLED);
+
+            printf("\n\n\n");
+            printf("Formula:\t%s\n", formula_str);
+            printf("Assignments:\t%s\n", formula_assign_str);
+
+            free(formula_str);
+            free(formula_assign_str);
+        }
+        #endif
+
+        // Assumptions are the first decisions
+        bool assumed;
+        if (!Formula_make_assumption(formula, &assumed)) {
+            result = FormulaStatus_FALSE;
+            break;
+        }
+        if (assumed) {
+            continue;
+        }
+
+        // Check if current assignment already made Formula true.
+        // Otherwise try to find another another Literal which hasn't been
+        // assigned a value.
+        // If we don't find one it means every Literal has a value and
+        // no Clause is false, so the current assignment makes the
+        // Formula true.
+        // When looking for all satisfying assignments only Variables of
+        // Clauses that are not true yet are assigned, so that every
+        // assignment stands for as many models as possible.
+        Literal decision;
+        bool found;
+        if (formula->model != NULL) {
+            found = Formula_choose_literal_of_open_clause(formula, &decision);
+        } else {
+            found = Formula_evaluate(formula) != FormulaStatus_TRUE &&
+                    Formula_choose_literal(formula, &decision);
+        }
+        if (!found) {
+            #if VERBOSE_DPLL
+                printf("  Found satisfying assignment\n");
+            #endif
+
+            // Look for more models in the untried branches for as long as
+            // they are wanted
+            if (formula->model == NULL || !formula->model(formula->model_data, formula)) {
+                result = FormulaStatus_TRUE;
+                break;
             }
+            if (!Formula_flip_last_decision(formula)) {
+                result = FormulaStatus_FALSE;
+                break;
+            }
+            continue;
+        }
+
+        #if VERBOSE_DPLL
+            printf("  Trying %s=%s\n",
+                   formula->names_v[Literal_get_variable(decision)],
+                   Literal_is_negated(decision) ? "false" : "true");
         #endif
 
-        if (Formula_dpll(formula)) {
-            LiteralAssignmentArray_destroy(assignment_array);
+        // Let waiting threads search the other branches of our earliest
+        // decisions
+        if (formula->split_queue != NULL && SplitQueue_is_hungry(formula->split_queue)) {
+            Formula_split(formula);
+        }
 
-            return true;
+        // Set the found Literal to the preferred assignment
+        Formula_decide(formula, decision);
+    }
+
+    // Failed assumptions only matter if the search was exhausted
+    Formula_clear_final(formula);
+    if (result != FormulaStatus_FALSE) {
+        formula->failed_c = 0;
+    }
+
+    return result;
+}
+
+static ClauseRef Formula_analyze_conflict(Formula* formula, ClauseRef conflict, unsigned int* backjump_level) {
+    // Walk the implication graph backwards along the trail, starting with
+    // the false Clause, until only one Literal of the current decision
+    // level is left (first unique implication point).
+    // Literals of lower decision levels are collected for the learned
+    // Clause on the way, the first slot is reserved for the negated unique
+    // implication point.
+    Literal* learned_literals = formula->learned_literals_v;
+    unsigned int learned_c = 1;
+    unsigned int current_level_c = 0;
+    unsigned int index = formula->trail_c;
+    Literal uip = 0;
+    bool uip_found = false;
+    ClauseRef ref = conflict;
+
+    do {
+        assert(ref != CLAUSEREF_UNDEF);
+        Clause* clause = ClauseArena_get(formula->arena, ref);
+
+        for (unsigned int i = 0; i < clause->literals_c; i++) {
+            Literal literal = clause->literals_v[i];
+            Variable variable = Literal_get_variable(literal);
+
+            // Skip the Literal implied by this Clause
+            if (uip_found && literal == uip) {
+                continue;
+            }
+
+            // Assignments on decision level 0 hold in every case
+            if (formula->seen_v[variable] || formula->levels_v[variable] == 0) {
+                continue;
+            }
+            formula->seen_v[variable] = true;
+            if (formula->decision_heuristic == DecisionHeuristic_VSIDS) {
+                Formula_bump_activity(formula, variable);
+            }
+
+            if (formula->levels_v[variable] == formula->decision_level) {
+                current_level_c++;
+            } else {
+                learned_literals[learned_c++] = literal;
+            }
         }
 
-        // If assignment wasn't correct set the Literal to the
-        // non-preferred assignment and rerun.
-        for (unsigned int p = 0; p < assignment_array->size; p++) {
-            assignment_array->assignments[p] = !assignment_array->assignments[p];
+        // Find the most recently assigned Literal that is part of the
+        // conflict and continue with the Clause that implied it.
+        do {
+            index--;
+        } while (!formula->seen_v[Literal_get_variable(formula->trail_v[index])]);
+
+        uip = formula->trail_v[index];
+        uip_found = true;
+        ref = formula->reasons_v[Literal_get_variable(uip)];
+        formula->seen_v[Literal_get_variable(uip)] = false;
+        current_level_c--;
+    } while (current_level_c > 0);
+    learned_literals[0] = Literal_negate(uip);
+
+    // Move the Literal of the highest remaining decision level to the
+    // second position, so that it is watched together with the negated
+    // unique implication point.
+    *backjump_level = 0;
+    for (unsigned int i = 1; i < learned_c; i++) {
+        Variable variable = Literal_get_variable(learned_literals[i]);
+        formula->seen_v[variable] = false;
+
+        if (formula->levels_v[variable] > *backjump_level) {
+            *backjump_level = formula->levels_v[variable];
+
+            Literal tmp = learned_literals[i];
+            learned_literals[i] = learned_literals[1];
+            learned_literals[1] = tmp;
         }
     }
 
-    // If neither makes the Formula true, we will restore the state
-    // of assignment from before false and return false.
-    for (unsigned int i = 0; i < assignment_array->size; i++) {
-        GenericLiteral* lit = assignment_array->literals[i];
-        GenericLiteral_unassign(lit);
+    // Create learned Clause
+    return ClauseArena_add(formula->arena, learned_literals, learned_c, true);
+}
+
+static void Formula_garbage_collect(Formula* formula) {
+    // Move all Clauses that are still in use into a new arena.
+    // Original and learned Clauses are moved first so that they keep their
+    // order, all other references just follow them.
+    ClauseArena* from = formula->arena;
+    ClauseArena* to = ClauseArena_create(from->size - from->wasted);
+
+    for (unsigned int i = 0; i < formula->clauses->size; i++) {
+        ClauseArena_relocate(from, to, &formula->clauses->data[i]);
+    }
+    for (unsigned int i = 0; i < formula->learned_clauses->size; i++) {
+        ClauseArena_relocate(from, to, &formula->learned_clauses->data[i]);
     }
 
-    // The algorithm will rerun with another variable on an upper level.
-    // (or it will just return false if the Formula is unsatisfiable)
-    LiteralAssignmentArray_destroy(assignment_array);
-    return false;
+    for (unsigned int i = 0; i < 2 * formula->variables_c; i++) {
+        ClauseRefVector* watches = formula->watches_v[i];
+        for (unsigned int p = 0; p < watches->size; p++) {
+            ClauseArena_relocate(from, to, &watches->data[p]);
+        }
+
+        if (formula->occurrences_v != NULL) {
+            ClauseRefVector* occurrences = formula->occurrences_v[i];
+            for (unsigned int p = 0; p < occurrences->size; p++) {
+                ClauseArena_relocate(from, to, &occurrences->data[p]);
+            }
+        }
+    }
+
+    // Reasons of unassigned Variables are outdated and might point to
+    // deleted Clauses.
+    for (Variable variable = 0; variable < formula->variables_c; variable++) {
+        if (formula->assignments_v[variable] == LiteralAssignment_UNSET) {
+            formula->reasons_v[variable] = CLAUSEREF_UNDEF;
+        } else if (formula->reasons_v[variable] != CLAUSEREF_UNDEF) {
+            ClauseArena_relocate(from, to, &formula->reasons_v[variable]);
+        }
+    }
+
+    #if VERBOSE_DPLL
+        printf("  Compacted clause arena from %u to %u words\n", from->size, to->size);
+    #endif
+
+    ClauseArena_destroy(from);
+    formula->arena = to;
+}
+
+// Learned Clause along with its length for sorting
+typedef struct {
+    unsigned int literals_c;
+    ClauseRef ref;
+} FormulaLearnedClause;
+
+/**
+ * Compares learned Clauses by number of Literals, longest first.
+**/
+static int Formula_compare_learned_clauses(const void* a, const void* b) {
+    unsigned int a_c = ((const FormulaLearnedClause*)a)->literals_c;
+    unsigned int b_c = ((const FormulaLearnedClause*)b)->literals_c;
+
+    return (a_c < b_c) - (a_c > b_c);
 }
 
+static void Formula_reduce_learned_clauses(Formula* formula) {
+    ClauseRefVector* learned_clauses = formula->learned_clauses;
+
+    // Sort learned Clauses so that the longest ones come first
+    FormulaLearnedClause* sorted_v = malloc(learned_clauses->size * sizeof(FormulaLearnedClause));
+    assert(sorted_v != NULL);
+    for (unsigned int i = 0; i < learned_clauses->size; i++) {
+        sorted_v[i].ref = learned_clauses->data[i];
+        sorted_v[i].literals_c = ClauseArena_get(formula->arena, learned_clauses->data[i])->literals_c;
+    }
+    qsort(sorted_v, learned_clauses->size, sizeof(FormulaLearnedClause), Formula_compare_learned_clauses);
+
+    // Delete the longer half of learned Clauses.
+    // Clauses that are the reason of a current assignment and binary
+    // Clauses are always kept.
+    unsigned int kept = 0;
+    for (unsigned int i = 0; i < learned_clauses->size; i++) {
+        ClauseRef ref = sorted_v[i].ref;
+        Clause* clause = ClauseArena_get(formula->arena, ref);
+        Variable variable = Literal_get_variable(clause->literals_v[0]);
+
+        bool locked = formula->assignments_v[variable] != LiteralAssignment_UNSET &&
+                      formula->reasons_v[variable] == ref;
+
+        if (i < learned_clauses->size / 2 && !locked && clause->literals_c > 2) {
+            if (formula->proof != NULL) {
+                Proof_delete(formula->proof, clause->literals_v, clause->literals_c);
+            }
+            ClauseArena_delete(formula->arena, ref);
+        } else {
+            learned_clauses->data[kept++] = ref;
+        }
+    }
+    free(sorted_v);
+
+    #if VERBOSE_DPLL
+        printf("  Deleted %u of %u learned clauses\n", learned_clauses->size - kept, learned_clauses->size);
+    #endif
+
+    ClauseRefVector_shrink(learned_clauses, kept);
+    formula->learned_limit *= FORMULA_LEARNED_LIMIT_GROWTH;
+
+    // Stop watching deleted Clauses
+    for (unsigned int i = 0; i < 2 * formula->variables_c; i++) {
+        ClauseRefVector* watches = formula->watches_v[i];
+        unsigned int watches_kept = 0;
+        for (unsigned int p = 0; p < watches->size; p++) {
+            if (!ClauseArena_get(formula->arena, watches->data[p])->deleted) {
+                watches->data[watches_kept++] = watches->data[p];
+            }
+        }
+        ClauseRefVector_shrink(watches, watches_kept);
+    }
+
+    // Reclaim memory of deleted Clauses
+    if (formula->arena->wasted > formula->arena->size * FORMULA_ARENA_WASTE_LIMIT) {
+        Formula_garbage_collect(formula);
+    }
+}
+
+/**
+ * Returns the number of different decision levels of the given Literals.
+**/
+static unsigned int Formula_count_levels(Formula* formula, const Literal* literals_v, unsigned int literals_c) {
+    // Start over with fresh marks once the counter wraps around
+    formula->level_stamp++;
+    if (formula->level_stamp == 0) {
+        memset(formula->level_stamps_v, 0, (formula->levels_capacity + 1) * sizeof(unsigned int));
+        formula->level_stamp = 1;
+    }
+
+    unsigned int levels_c = 0;
+    for (unsigned int i = 0; i < literals_c; i++) {
+        unsigned int level = formula->levels_v[Literal_get_variable(literals_v[i])];
+
+        if (formula->level_stamps_v[level] != formula->level_stamp) {
+            formula->level_stamps_v[level] = formula->level_stamp;
+            levels_c++;
+        }
+    }
+
+    return levels_c;
+}
+
+/**
+ * Returns the element at the given index of the Luby sequence
+ * (1, 1, 2, 1, 1, 2, 4, 1, 1, 2, 1, 1, 2, 4, 8, ...).
+**/
+static unsigned int Formula_luby(unsigned int index) {
+    // Find the smallest complete subsequence (of length 2^k - 1)
+    // containing the index
+    unsigned int size = 1;
+    unsigned int exponent = 0;
+    while (size < index + 1) {
+        exponent++;
+        size = 2 * size + 1;
+    }
+
+    // Descend into the repeated halves of the subsequence until the index
+    // is its last element
+    while (size - 1 != index) {
+        size = (size - 1) / 2;
+        exponent--;
+        index = index % size;
+    }
+
+    return 1u << exponent;
+}
+
+/**
+ * Adds all Clauses other solvers exported since the last import.
+ *
+ * Must only be called on decision level 0. Literals that are false on
+ * this level are left out and Clauses that are already true are skipped.
+ * Returns false if an imported Clause is false.
+**/
+static bool Formula_import_clauses(Formula* formula) {
+    const Literal* literals_v;
+    unsigned int literals_c;
+
+    while (ClauseExchangePort_import(formula->exchange, &literals_v, &literals_c)) {
+        Literal* kept_literals = formula->learned_literals_v;
+        unsigned int kept_c = 0;
+        bool satisfied = false;
+
+        for (unsigned int i = 0; i < literals_c && !satisfied; i++) {
+            switch (Formula_get_assignment(formula, literals_v[i])) {
+                case LiteralAssignment_TRUE:
+                    satisfied = true;
+                    break;
+                case LiteralAssignment_FALSE:
+                    break;
+                case LiteralAssignment_UNSET:
+                    kept_literals[kept_c++] = literals_v[i];
+                    break;
+            }
+        }
+
+        if (satisfied) {
+            continue;
+        }
+        if (kept_c == 0) {
+            return false;
+        }
+
+        ClauseRef ref = ClauseArena_add(formula->arena, kept_literals, kept_c, true);
+        ClauseRefVector_append(formula->learned_clauses, ref);
+
+        if (kept_c == 1) {
+            Formula_assign(formula, kept_literals[0], ref);
+        } else {
+            ClauseRefVector_append(formula->watches_v[kept_literals[0]], ref);
+            ClauseRefVector_append(formula->watches_v[kept_literals[1]], ref);
+        }
+    }
+
+    return true;
+}
+
+FormulaStatus Formula_cdcl(Formula* formula) {
+    // Start over if the Formula was searched before
+    Formula_backtrack_to_level(formula, 0);
+    formula->failed_c = 0;
+
+    // Formula contains an empty Clause or contradicting One-Literal-Clauses
+    if (formula->inconsistent) {
+        if (formula->proof != NULL) {
+            Proof_add(formula->proof, NULL, 0);
+        }
+        return FormulaStatus_FALSE;
+    }
+
+    while (true) {
+        if (Formula_is_stopped(formula)) {
+            return FormulaStatus_UNDECIDED;
+        }
+
+        ClauseRef conflict = Formula_unit_propagate(formula);
+
+        if (conflict != CLAUSEREF_UNDEF) {
+            if (formula->collect_core) {
+                Formula_mark_core(formula, conflict);
+            }
+
+            // A conflict without any decisions can't be resolved, nor
+            // can it be found again by later searches
+            if (formula->decision_level == 0) {
+                formula->inconsistent = true;
+                if (formula->proof != NULL) {
+                    Proof_add(formula->proof, NULL, 0);
+                }
+                return FormulaStatus_FALSE;
+            }
+
+            unsigned int backjump_level;
+            ClauseRef learned_ref = Formula_analyze_conflict(formula, conflict, &backjump_level);
+            Clause* learned = ClauseArena_get(formula->arena, learned_ref);
+            ClauseRefVector_append(formula->learned_clauses, learned_ref);
+            Formula_decay_activities(formula);
+            formula->restart_conflicts_c++;
+
+            if (formula->learn != NULL) {
+                formula->learn(formula->learn_data, learned->literals_v, learned->literals_c);
+            }
+            if (formula->proof != NULL) {
+                Proof_add(formula->proof, learned->literals_v, learned->literals_c);
+            }
+
+            // Share the learned Clause while the decision levels of its
+            // Literals are still known
+            if (formula->exchange != NULL) {
+                unsigned int lbd = Formula_count_levels(formula, learned->literals_v, learned->literals_c);
+                ClauseExchangePort_export(formula->exchange, learned->literals_v, learned->literals_c, lbd);
+            }
+
+            #if VERBOSE_DPLL
+            {
+                char* clause_str = Clause_to_string(learned, formula->names_v, formula->assignments_v, CONSTANTS_COLOR_ENABLED);
+                printf("  Learned %s, jumping back to level %u\n", clause_str, backjump_level);
+                free(clause_str);
+            }
+            #endif
+
+            // Jump back to the level on which the learned Clause becomes
+            // a One-Literal-Clause and assign its only unassigned Literal.
+            Formula_backtrack_to_level(formula, backjump_level);
+
+            if (learned->literals_c > 1) {
+                ClauseRefVector_append(formula->watches_v[learned->literals_v[0]], learned_ref);
+                ClauseRefVector_append(formula->watches_v[learned->literals_v[1]], learned_ref);
+            }
+            Formula_assign(formula, learned->literals_v[0], learned_ref);
+            continue;
+        }
+
+        // Start over from decision level 0, keeping learned Clauses and
+        // activities
+        if (formula->restart_conflicts_c >= Formula_luby(formula->restarts_c) * FORMULA_RESTART_INTERVAL) {
+            #if VERBOSE_DPLL
+                printf("  Restarting after %u conflicts\n", formula->restart_conflicts_c);
+            #endif
+
+            Formula_backtrack_to_level(formula, 0);
+            formula->restart_conflicts_c = 0;
+            formula->restarts_c++;
+        }
+
+        // Pick up Clauses learned by other solvers
+        if (formula->exchange != NULL && formula->decision_level == 0) {
+            unsigned int trail_c = formula->trail_c;
+            if (!Formula_import_clauses(formula)) {
+                formula->inconsistent = true;
+                return FormulaStatus_FALSE;
+            }
+
+            // Propagate imported One-Literal-Clauses first
+            if (formula->trail_c > trail_c) {
+                continue;
+            }
+        }
+
+        // Forget learned Clauses if there are too many
+        if (formula->learned_clauses->size >= formula->learned_limit + formula->trail_c) {
+            Formula_reduce_learned_clauses(formula);
+        }
+
+        // Assumptions are the first decisions
+        bool assumed;
+        if (!Formula_make_assumption(formula, &assumed)) {
+            Formula_clear_final(formula);
+            return FormulaStatus_FALSE;
+        }
+        if (assumed) {
+            continue;
+        }
+
+        // Every Literal has a value and no Clause is false
+        Literal decision;
+        if (!Formula_choose_literal(formula, &decision)) {
+            return FormulaStatus_TRUE;
+        }
+
+        Formula_decide(formula, decision);
+    }
+}
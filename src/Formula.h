@@ -18,9 +18,16 @@
 #define FORMULA_H
 
 
+#include "ActivityHeap.h"
 #include "Clause.h"
-#include "LinkedList.h"
+#include "ClauseArena.h"
+#include "ClauseExchange.h"
+#include "ClauseRefVector.h"
+#include "Proof.h"
+#include "SplitQueue.h"
+#include "StringTable.h"
 
+#include <stdatomic.h>
 #include <stdbool.h>
 
 
@@ -37,63 +44,424 @@ typedef enum {
     FormulaStatus_UNDECIDED
 } FormulaStatus;
 
+/**
+ * Represents the possible strategies for choosing the next Literal
+ * to assign a value to.
+ *
+ * FIRST_UNSET - First unassigned Literal of the Formula
+ * VSIDS - Unassigned Literal with the highest activity, which is increased
+ *         whenever a Literal is involved in a conflict and decays
+ *         exponentially with every conflict
+**/
+typedef enum {
+    DecisionHeuristic_FIRST_UNSET,
+    DecisionHeuristic_VSIDS
+} DecisionHeuristic;
+
+/**
+ * Represents the possible strategies for choosing the value a decision
+ * assigns to the chosen Variable.
+ *
+ * POSITIVE - Always true
+ * NEGATIVE - Always false
+ * SAVED - Value the Variable had before it was last unassigned
+ *         (true if it was never assigned)
+ * RANDOM - Random value
+**/
+typedef enum {
+    DecisionPhase_POSITIVE,
+    DecisionPhase_NEGATIVE,
+    DecisionPhase_SAVED,
+    DecisionPhase_RANDOM
+} DecisionPhase;
+
+typedef struct Formula Formula;
+
+/**
+ * Called with the Literals of every Clause learned by CDCL.
+**/
+typedef void (*FormulaLearnCallback)(void* data, const Literal* literals_v, unsigned int literals_c);
+
+/**
+ * Polled while searching, the search stops as soon as it returns true.
+**/
+typedef bool (*FormulaTerminateCallback)(void* data);
+
+/**
+ * Called with every satisfying assignment found by DPLL, Variables that
+ * are unassigned can have any value. The search goes on for as long as
+ * it returns true.
+**/
+typedef bool (*FormulaModelCallback)(void* data, Formula* formula);
+
 /**
  * Represents a formula of propositional logic in conjunctive normal form.
  *
  * A Formula contains Clauses, which contain Literals.
  * For a Formula to be true all contained Clauses have to be true.
 **/
-typedef struct {
-    LinkedList* clauses;
-    GenericLiteral** all_literals_v;
-    unsigned int all_literals_c;
-} Formula;
+struct Formula {
+    // Storage of all original and learned Clauses
+    ClauseArena* arena;
+
+    // Original Clauses of the Formula
+    ClauseRefVector* clauses;
+
+    // Names of all Variables, only used for output and for finding
+    // Variables by name. If name_table is set it holds the names and
+    // names_v are its strings, otherwise Variables are named by their
+    // number starting at 1 like in DIMACS.
+    // Copies of a Formula share the names of the original.
+    char** names_v;
+    StringTable* name_table;
+    unsigned int variables_c;
+    bool owns_names;
+
+    // Current assignment of every Variable
+    LiteralAssignment* assignments_v;
+
+    // For every Literal the Clauses in which this Literal is one of the
+    // two watched Literals.
+    // The watched Literals of a Clause are always its first two Literals.
+    ClauseRefVector** watches_v;
+
+    // All assigned Literals (that are true) in order of assignment.
+    // Literals after propagation_head have not been propagated yet.
+    Literal* trail_v;
+    unsigned int trail_c;
+    unsigned int propagation_head;
+
+    // For every decision level the position of its decision in the trail
+    // and whether the decision was already flipped to its other branch.
+    // There is room for a level for every Variable and every assumption.
+    unsigned int* trail_lim_v;
+    bool* flipped_v;
+    unsigned int decision_level;
+    unsigned int levels_capacity;
+
+    // Implication graph: For every Variable the decision level it was
+    // assigned on and the Clause that implied its assignment
+    // (CLAUSEREF_UNDEF for decisions).
+    unsigned int* levels_v;
+    ClauseRef* reasons_v;
+
+    // Clauses learned from conflicts.
+    // Once there are more than learned_limit of them the longer half is
+    // deleted.
+    ClauseRefVector* learned_clauses;
+    unsigned int learned_limit;
+
+    // Marks of Variables and buffer for Literals of the learned Clause
+    // used while analyzing conflicts
+    bool* seen_v;
+    Literal* learned_literals_v;
+
+    // Marks of Literals and buffer for the Literals of a Clause used while
+    // adding Clauses, kept so that adding Clauses one by one doesn't
+    // allocate
+    bool* literal_marks_v;
+    Literal* clause_literals_v;
+
+    // Marks of decision levels used for counting the different decision
+    // levels of a learned Clause
+    unsigned int* level_stamps_v;
+    unsigned int level_stamp;
+
+    // Number of conflicts since the last restart and number of restarts.
+    // Restarts happen after a number of conflicts following the Luby
+    // sequence.
+    unsigned int restart_conflicts_c;
+    unsigned int restarts_c;
+
+    // Strategy for choosing decisions.
+    // For VSIDS all unassigned Variables are kept in a heap ordered by
+    // activity.
+    DecisionHeuristic decision_heuristic;
+    ActivityHeap* activity_heap;
+    double activity_increment;
+
+    // Strategy for choosing the value of decisions along with the last
+    // value of every Variable (true if it was negated) and the state of
+    // the random number generator.
+    DecisionPhase decision_phase;
+    bool* phases_v;
+    unsigned int random_state;
+
+    // For every Literal the Clauses containing it.
+    // Only present while the status of Clauses is tracked, in which case
+    // the number of true and false Clauses is kept up to date as well.
+    ClauseRefVector** occurrences_v;
+    unsigned int true_clauses_c;
+    unsigned int false_clauses_c;
+
+    // Variables that were eliminated by preprocessing and occur in no
+    // Clause, they are never chosen as decisions
+    bool* eliminated_v;
+
+    // Whether the Formula contains an empty Clause or contradicting
+    // One-Literal-Clauses.
+    bool inconsistent;
+
+    // Literals that are assumed to be true for the next search by making
+    // them the first decisions, along with the assumptions that were
+    // responsible for the Formula being unsatisfiable in the last search.
+    Literal* assumptions_v;
+    unsigned int assumptions_c;
+    unsigned int assumptions_capacity;
+    Literal* failed_v;
+    unsigned int failed_c;
+
+    // Whether DPLL collects the failed assumptions, which takes a walk
+    // along the trail on every conflict
+    bool collect_failed;
+
+    // Whether every Clause that takes part in a conflict is marked as
+    // part of the unsatisfiable core, which takes a walk along the trail
+    // on every conflict as well. Only works without assumptions.
+    bool collect_core;
+
+    // If set the search is aborted as soon as this becomes true or the
+    // terminate callback returns true
+    atomic_bool* stop;
+    FormulaTerminateCallback terminate;
+    void* terminate_data;
+
+    // If set called with every learned Clause
+    FormulaLearnCallback learn;
+    void* learn_data;
+
+    // If set called with every satisfying assignment
+    FormulaModelCallback model;
+    void* model_data;
+
+    // If set learned Clauses are shared with other solvers working on
+    // copies of this Formula (only by CDCL).
+    ClauseExchangePort* exchange;
+
+    // If set DPLL gives away the untried branches of its earliest
+    // decisions whenever other threads are waiting for work.
+    SplitQueue* split_queue;
+
+    // If set every Clause learned by CDCL, every refuted combination of
+    // decisions of DPLL and every deleted Clause is written to it, so
+    // that a search without assumptions that finds the Formula
+    // unsatisfiable leaves a proof ending with the empty Clause.
+    Proof* proof;
+};
+
+/**
+ * Search procedure deciding whether a Formula is satisfiable.
+**/
+typedef FormulaStatus (*FormulaEngine)(Formula* formula);
 
 
 /**
  * Creates a new Formula.
+ *
+ * All Literals of the given Clauses must belong to Variables below
+ * variables_c. The Formula takes ownership of the arena, the list of
+ * Clauses and the names. Variables are only found by name if their names
+ * are their numbers starting at 1.
+**/
+Formula* Formula_create(ClauseArena* arena, ClauseRefVector* clauses, char** names_v, unsigned int variables_c);
+
+/**
+ * Creates a new Formula whose Variables are named by the strings of a
+ * StringTable, the Formula takes ownership of it as well.
+**/
+Formula* Formula_create_named(ClauseArena* arena, ClauseRefVector* clauses, StringTable* name_table);
+
+/**
+ * Creates an unassigned copy of the original Clauses of a Formula.
+ *
+ * The copy has its own Clauses and search state, the names of Variables
+ * are shared with the given Formula and must outlive the copy.
+ * The given Formula is only read, so several threads can copy the same
+ * Formula at the same time.
 **/
-Formula* Formula_create(LinkedList* clauses, GenericLiteral** all_literals_v, unsigned int all_literals_c);
+Formula* Formula_copy(Formula* formula);
 
 /**
  * Destroys a Formula.
 **/
 void Formula_destroy(Formula* formula);
 
+/**
+ * Adds Variables to the Formula until it has at least variables_c
+ * Variables, new Variables are named by their number.
+ *
+ * Only possible for Formulas that own their names.
+**/
+void Formula_add_variables(Formula* formula, unsigned int variables_c);
+
+/**
+ * Adds a Clause to the Formula, which may have been searched before.
+ *
+ * All assignments except the ones on decision level 0 are removed. As
+ * those hold in every case the Clause is left out if it is true under
+ * them and Literals that are false under them are removed from it.
+ * The Variables of all Literals must already exist.
+**/
+void Formula_add_clause(Formula* formula, const Literal* literals_v, unsigned int literals_c);
+
+/**
+ * Replaces the original Clauses of a Formula that has no learned Clauses
+ * by the given ones, the Formula takes ownership of the arena and the
+ * list of Clauses.
+ *
+ * All assignments are removed, the new Clauses are watched and their
+ * One-Literal-Clauses assigned as by Formula_create.
+**/
+void Formula_replace_clauses(Formula* formula, ClauseArena* arena, ClauseRefVector* clauses);
+
+/**
+ * Sets the Literals that are assumed to be true in all following
+ * searches (until the assumptions are set again).
+ *
+ * If a search finds the Formula to be unsatisfiable under the assumptions
+ * failed_v contains the assumptions that were needed for that.
+**/
+void Formula_set_assumptions(Formula* formula, const Literal* literals_v, unsigned int literals_c);
+
+/**
+ * Finds the Variable with the given name in constant (expected) time.
+ *
+ * Returns false if there is no such Variable.
+**/
+bool Formula_find_variable(Formula* formula, const char* name, Variable* variable);
+
+/**
+ * Seeds the random number generator and gives every Variable a tiny
+ * random initial activity, so that Formulas with different seeds search
+ * differently.
+**/
+void Formula_set_seed(Formula* formula, unsigned int seed);
+
 /**
  * Represent this Formula as a string.
 **/
 char* Formula_to_string(Formula* formula, bool color);
 
 /**
- * Represent current assignments of Literals as a string.
+ * Represent current assignments of Variables as a string.
  *
- * If print_all is false Literals that are not set will not be included
+ * If print_all is false Variables that are not set will not be included
  * in the string.
 **/
 char* Formula_to_assignment_string(Formula* formula, bool print_all, bool color);
 
 /**
- * Select Literal(s) (that are currently unassigned) from
- * One-Literal-Clauses to assign a value to.
+ * Make the given (unassigned) Literal true and add it to the queue of
+ * Literals which still have to be propagated.
  *
- * Select unassigned Literals from One-Literal-Clauses along with
- * assignments which will most likely satisfy the Formula.
+ * The reason is the Clause which implied this assignment or
+ * CLAUSEREF_UNDEF if the assignment is a decision.
+**/
+void Formula_assign(Formula* formula, Literal literal, ClauseRef reason);
+
+/**
+ * Remove assignments of all Literals that were assigned after the trail
+ * contained trail_mark Literals.
+**/
+void Formula_backtrack(Formula* formula, unsigned int trail_mark);
+
+/**
+ * Start a new decision level with the given Literal as its decision.
+**/
+void Formula_decide(Formula* formula, Literal decision);
+
+/**
+ * Remove all assignments of decision levels above the given level.
+**/
+void Formula_backtrack_to_level(Formula* formula, unsigned int level);
+
+/**
+ * Propagate all queued assignments.
  *
- * Returns NULL if no unassigned Literals from One-Literal-Clauses are left.
+ * Only Clauses watching a Literal that just became false are visited.
+ * Clauses that become One-Literal-Clauses have their last unassigned
+ * Literal assigned (and propagated as well).
+ *
+ * Returns a Clause that became false or CLAUSEREF_UNDEF if there was no
+ * conflict.
 **/
-LiteralAssignmentArray* Formula_unit_propagate(Formula* formula);
+ClauseRef Formula_unit_propagate(Formula* formula);
 
 /**
- * Select next Literal (that is currently unassigned) to assign a
+ * Select next Variable (that is currently unassigned) to assign a
  * value to along with guess for best assignment.
  *
- * Returns NULL if no unassigned Literals are left.
+ * The chosen Literal is written to decision, its sign represents the
+ * guessed assignment.
+ * Returns false if no unassigned Variables are left.
+**/
+bool Formula_choose_literal(Formula* formula, Literal* decision);
+
+/**
+ * Start keeping the status of every Clause up to date on every
+ * assignment and unassignment.
+ *
+ * This makes Formula_evaluate constant time.
 **/
-LiteralAssignmentArray* Formula_choose_literal(Formula* formula);
+void Formula_track_clause_status(Formula* formula);
 
+/**
+ * Evaluates this Formula for the current assignment.
+ *
+ * Takes constant time if the status of Clauses is tracked, otherwise
+ * all Clauses are evaluated.
+**/
 FormulaStatus Formula_evaluate(Formula* formula);
 
-bool Formula_dpll(Formula* formula);
+/**
+ * Returns the current assignment of a Literal.
+**/
+static inline LiteralAssignment Formula_get_assignment(Formula* formula, Literal literal) {
+    return Literal_evaluate(literal, formula->assignments_v);
+}
+
+/**
+ * Decide whether this Formula is satisfiable.
+ *
+ * The search is iterative and chronologically backtracks to the most
+ * recent decision whose other branch has not been tried yet.
+ * Assumptions are made as the first decisions and are never flipped.
+ * The assumptions involved in conflicts are collected, if the search
+ * below them is exhausted they are in failed_v.
+ * The search starts over from decision level 0 on every call.
+ * If the Formula has a model callback the search goes on after every
+ * satisfying assignment by backtracking chronologically as after a
+ * conflict, until the callback returns false (then TRUE is returned) or
+ * all of them were found (then FALSE is returned). The assignments
+ * cover disjoint sets of models.
+ * If the Formula has a SplitQueue that is hungry the other branch of the
+ * earliest decision is given away to it before the next decision.
+ * If the Formula is satisfiable the satisfying assignment is kept.
+ * Returns UNDECIDED if the search was stopped.
+**/
+FormulaStatus Formula_dpll(Formula* formula);
+
+/**
+ * Decide whether this Formula is satisfiable using conflict-driven
+ * clause learning.
+ *
+ * Every conflict is analyzed in the implication graph up to the first
+ * unique implication point. The resulting Clause is learned and the
+ * search jumps back to the second highest decision level in it.
+ * When there are too many learned Clauses the longer half of them is
+ * deleted and the memory of deleted Clauses is reclaimed from time to
+ * time.
+ * Assumptions are made as the first decisions, if one of them becomes
+ * false the assumptions that lead to this are collected in failed_v.
+ * The search can be repeated after adding Clauses or changing the
+ * assumptions, learned Clauses are kept between searches.
+ * The search restarts from decision level 0 after a growing number of
+ * conflicts. If the Formula has a ClauseExchangePort short learned
+ * Clauses are exported and Clauses of other solvers are imported
+ * whenever the search is on decision level 0.
+ * If the Formula is satisfiable the satisfying assignment is kept.
+ * Returns UNDECIDED if the search was stopped.
+**/
+FormulaStatus Formula_cdcl(Formula* formula);
 
 #endif
@@ -0,0 +1,115 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+
+
+#include "InputFile.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+InputFile* InputFile_open(const char* path) {
+    assert(path != NULL);
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Error - could not open '%s': %s\n", path, strerror(errno));
+        return NULL;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        fprintf(stderr, "Error - could not stat '%s': %s\n", path, strerror(errno));
+        close(fd);
+        return NULL;
+    }
+
+    // Pipes, devices and empty files can't be mapped
+    if (!S_ISREG(info.st_mode) || info.st_size == 0) {
+        FILE* stream = fdopen(fd, "r");
+        assert(stream != NULL);
+
+        InputFile* file = InputFile_read(stream);
+        fclose(stream);
+        return file;
+    }
+
+    void* data = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        fprintf(stderr, "Error - could not map '%s': %s\n", path, strerror(errno));
+        return NULL;
+    }
+
+    // The file is parsed front to back exactly once
+    madvise(data, info.st_size, MADV_SEQUENTIAL);
+
+    InputFile* file = malloc(sizeof(InputFile));
+    assert(file != NULL);
+
+    file->data = data;
+    file->length = info.st_size;
+    file->mapped = true;
+
+    return file;
+}
+
+InputFile* InputFile_read(FILE* stream) {
+    assert(stream != NULL);
+
+    char* data = NULL;
+    size_t size = 0;
+    size_t filled = 0;
+
+    while (!feof(stream) && !ferror(stream)) {
+        // Grow buffer exponentially
+        if (filled == size) {
+            size = (size == 0) ? BUFSIZ : size * 2;
+            data = realloc(data, size);
+            assert(data != NULL);
+        }
+
+        filled += fread(data + filled, 1, size - filled, stream);
+    }
+
+    InputFile* file = malloc(sizeof(InputFile));
+    assert(file != NULL);
+
+    file->data = data;
+    file->length = filled;
+    file->mapped = false;
+
+    return file;
+}
+
+void InputFile_close(InputFile* file) {
+    assert(file != NULL);
+
+    if (file->mapped) {
+        munmap((void*)file->data, file->length);
+    } else {
+        free((void*)file->data);
+    }
+
+    free(file);
+}
@@ -0,0 +1,62 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+
+
+#ifndef INPUTFILE_H
+#define INPUTFILE_H
+
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+
+/**
+ * Represents the complete content of an input file.
+ *
+ * Regular files are mapped into memory instead of being copied, all other
+ * input is read into a buffer.
+ * The data is not terminated by '\0'.
+**/
+typedef struct {
+    const char* data;
+    size_t length;
+
+    // Whether data is mapped from a file or was read into a buffer
+    bool mapped;
+} InputFile;
+
+
+/**
+ * Opens the file at the given path and makes its content available.
+ *
+ * Returns NULL if the file can't be read.
+**/
+InputFile* InputFile_open(const char* path);
+
+/**
+ * Reads the complete content of a stream (e.g. stdin) into a buffer.
+**/
+InputFile* InputFile_read(FILE* stream);
+
+/**
+ * Releases the content and destroys an InputFile.
+**/
+void InputFile_close(InputFile* file);
+
+
+#endif
@@ -0,0 +1,258 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+#include "ipasir.h"
+#include "Formula.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/**
+ * State of a solver behind the IPASIR interface.
+**/
+typedef struct {
+    Formula* formula;
+
+    // Literals of the Clause that is currently being added
+    Literal* clause_v;
+    unsigned int clause_c;
+    unsigned int clause_capacity;
+
+    // Assumptions for the next call of ipasir_solve
+    Literal* assumptions_v;
+    unsigned int assumptions_c;
+    unsigned int assumptions_capacity;
+
+    // For every Literal whether it is a failed assumption of the last
+    // search
+    bool* failed_v;
+    unsigned int failed_capacity;
+
+    int (*terminate)(void* data);
+    void* terminate_data;
+
+    void (*learn)(void* data, int32_t* clause);
+    void* learn_data;
+    unsigned int learn_max_length;
+    int32_t* learn_clause_v;
+} IpasirSolver;
+
+
+/**
+ * Converts an IPASIR Literal, creating its Variable if it does not exist
+ * yet.
+**/
+static Literal Ipasir_to_literal(IpasirSolver* solver, int32_t lit) {
+    assert(lit != 0 && lit != INT32_MIN);
+
+    Variable variable = (Variable)((lit < 0) ? -lit : lit) - 1;
+    Formula_add_variables(solver->formula, variable + 1);
+
+    return Literal_create(variable, lit < 0);
+}
+
+static int32_t Ipasir_from_literal(Literal literal) {
+    int32_t lit = (int32_t)Literal_get_variable(literal) + 1;
+    return Literal_is_negated(literal) ? -lit : lit;
+}
+
+static bool Ipasir_terminate(void* data) {
+    IpasirSolver* solver = data;
+    return solver->terminate(solver->terminate_data) != 0;
+}
+
+static void Ipasir_learn(void* data, const Literal* literals_v, unsigned int literals_c) {
+    IpasirSolver* solver = data;
+    if (literals_c > solver->learn_max_length) {
+        return;
+    }
+
+    for (unsigned int i = 0; i < literals_c; i++) {
+        solver->learn_clause_v[i] = Ipasir_from_literal(literals_v[i]);
+    }
+    solver->learn_clause_v[literals_c] = 0;
+    solver->learn(solver->learn_data, solver->learn_clause_v);
+}
+
+/**
+ * Appends a Literal to a growable array.
+**/
+static void Ipasir_append(Literal** literals_v, unsigned int* literals_c, unsigned int* capacity, Literal literal) {
+    if (*literals_c == *capacity) {
+        *capacity = (*capacity == 0) ? 16 : 2 * *capacity;
+        *literals_v = realloc(*literals_v, *capacity * sizeof(Literal));
+        assert(*literals_v != NULL);
+    }
+
+    (*literals_v)[(*literals_c)++] = literal;
+}
+
+const char* ipasir_signature(void) {
+    return "dpll (CDCL)";
+}
+
+void* ipasir_init(void) {
+    IpasirSolver* solver = malloc(sizeof(IpasirSolver));
+    assert(solver != NULL);
+
+    solver->formula = Formula_create(ClauseArena_create(1024), ClauseRefVector_create(16), NULL, 0);
+    solver->formula->decision_heuristic = DecisionHeuristic_VSIDS;
+    solver->formula->decision_phase = DecisionPhase_SAVED;
+
+    solver->clause_v = NULL;
+    solver->clause_c = 0;
+    solver->clause_capacity = 0;
+    solver->assumptions_v = NULL;
+    solver->assumptions_c = 0;
+    solver->assumptions_capacity = 0;
+    solver->failed_v = NULL;
+    solver->failed_capacity = 0;
+
+    solver->terminate = NULL;
+    solver->terminate_data = NULL;
+    solver->learn = NULL;
+    solver->learn_data = NULL;
+    solver->learn_max_length = 0;
+    solver->learn_clause_v = NULL;
+
+    return solver;
+}
+
+void ipasir_release(void* data) {
+    IpasirSolver* solver = data;
+    assert(solver != NULL);
+
+    Formula_destroy(solver->formula);
+    free(solver->clause_v);
+    free(solver->assumptions_v);
+    free(solver->failed_v);
+    free(solver->learn_clause_v);
+    free(solver);
+}
+
+void ipasir_add(void* data, int32_t lit_or_zero) {
+    IpasirSolver* solver = data;
+    assert(solver != NULL);
+
+    if (lit_or_zero != 0) {
+        Literal literal = Ipasir_to_literal(solver, lit_or_zero);
+        Ipasir_append(&solver->clause_v, &solver->clause_c, &solver->clause_capacity, literal);
+        return;
+    }
+
+    Formula_add_clause(solver->formula, solver->clause_v, solver->clause_c);
+    solver->clause_c = 0;
+}
+
+void ipasir_assume(void* data, int32_t lit) {
+    IpasirSolver* solver = data;
+    assert(solver != NULL);
+
+    Literal literal = Ipasir_to_literal(solver, lit);
+    Ipasir_append(&solver->assumptions_v, &solver->assumptions_c, &solver->assumptions_capacity, literal);
+}
+
+int ipasir_solve(void* data) {
+    IpasirSolver* solver = data;
+    assert(solver != NULL);
+
+    Formula* formula = solver->formula;
+    Formula_set_assumptions(formula, solver->assumptions_v, solver->assumptions_c);
+    solver->assumptions_c = 0;
+
+    FormulaStatus result = Formula_cdcl(formula);
+
+    // Remember failed assumptions for lookup by Literal
+    if (solver->failed_capacity < 2 * formula->variables_c) {
+        solver->failed_capacity = 2 * formula->variables_c;
+        solver->failed_v = realloc(solver->failed_v, solver->failed_capacity * sizeof(bool));
+        assert(solver->failed_v != NULL);
+    }
+    memset(solver->failed_v, 0, solver->failed_capacity * sizeof(bool));
+    for (unsigned int i = 0; i < formula->failed_c; i++) {
+        solver->failed_v[formula->failed_v[i]] = true;
+    }
+
+    switch (result) {
+        case FormulaStatus_TRUE:
+            return 10;
+        case FormulaStatus_FALSE:
+            return 20;
+        case FormulaStatus_UNDECIDED:
+        default:
+            return 0;
+    }
+}
+
+int32_t ipasir_val(void* data, int32_t lit) {
+    IpasirSolver* solver = data;
+    assert(solver != NULL);
+    assert(lit != 0 && lit != INT32_MIN);
+
+    Variable variable = (Variable)((lit < 0) ? -lit : lit) - 1;
+    if (variable >= solver->formula->variables_c) {
+        return 0;
+    }
+
+    switch (Formula_get_assignment(solver->formula, Literal_create(variable, lit < 0))) {
+        case LiteralAssignment_TRUE:
+            return lit;
+        case LiteralAssignment_FALSE:
+            return -lit;
+        case LiteralAssignment_UNSET:
+        default:
+            return 0;
+    }
+}
+
+int ipasir_failed(void* data, int32_t lit) {
+    IpasirSolver* solver = data;
+    assert(solver != NULL);
+    assert(lit != 0 && lit != INT32_MIN);
+
+    Variable variable = (Variable)((lit < 0) ? -lit : lit) - 1;
+    Literal literal = Literal_create(variable, lit < 0);
+    if (literal >= solver->failed_capacity) {
+        return 0;
+    }
+
+    return solver->failed_v[literal] ? 1 : 0;
+}
+
+void ipasir_set_terminate(void* data, void* terminate_data, int (*terminate)(void* data)) {
+    IpasirSolver* solver = data;
+    assert(solver != NULL);
+
+    solver->terminate = terminate;
+    solver->terminate_data = terminate_data;
+    solver->formula->terminate = (terminate != NULL) ? Ipasir_terminate : NULL;
+    solver->formula->terminate_data = solver;
+}
+
+void ipasir_set_learn(void* data, void* learn_data, int max_length, void (*learn)(void* data, int32_t* clause)) {
+    IpasirSolver* solver = data;
+    assert(solver != NULL);
+
+    solver->learn = learn;
+    solver->learn_data = learn_data;
+    solver->learn_max_length = (max_length > 0) ? (unsigned int)max_length : 0;
+    solver->learn_clause_v = realloc(solver->learn_clause_v, (solver->learn_max_length + 1) * sizeof(int32_t));
+    assert(solver->learn_clause_v != NULL);
+    solver->formula->learn = (learn != NULL) ? Ipasir_learn : NULL;
+    solver->formula->learn_data = solver;
+}
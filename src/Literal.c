@@ -22,56 +22,26 @@
 #include <string.h>
 
 
-Literal* Literal_create(GenericLiteral* generic_literal, bool negated) {
-    assert(generic_literal != NULL);
+char* Literal_to_string(Literal literal, char* name, LiteralAssignment assignment, bool color) {
+    assert(name != NULL);
 
-    Literal* literal = malloc(sizeof(Literal));
-    assert(literal != NULL);
-
-    literal->generic_literal = generic_literal;
-    literal->negated = negated;
-
-    return literal;
-}
-
-void Literal_destroy(Literal* literal) {
-    assert(literal != NULL);
-
-    // Don't free GenericLiteral!
-
-    // Free Literal
-    free(literal);
-}
-
-Literal* Literal_clone(Literal* literal) {
-    Literal* cloned_literal = NULL;
-    if (literal->negated) {
-        cloned_literal = Literal_create(literal->generic_literal, true);
-    } else {
-        cloned_literal = Literal_create(literal->generic_literal, false);
-    }
-
-    return cloned_literal;
-}
-
-char* Literal_to_string(Literal* literal, bool color) {
-    assert(literal != NULL);
+    bool negated = Literal_is_negated(literal);
 
     // Create string
     StringBuilder* builder = StringBuilder_create(10);
 
     // If color is wanted add the correct color code to string
     if (color) {
-        switch(literal->generic_literal->assignment) {
+        switch(assignment) {
         case LiteralAssignment_TRUE:
-            if (literal->negated) {
+            if (negated) {
                 StringBuilder_append_string(builder, CONSTANTS_COLOR_PREFIX_FALSE);
             } else {
                 StringBuilder_append_string(builder, CONSTANTS_COLOR_PREFIX_TRUE);
             }
             break;
         case LiteralAssignment_FALSE:
-            if (literal->negated) {
+            if (negated) {
                 StringBuilder_append_string(builder, CONSTANTS_COLOR_PREFIX_TRUE);
             } else {
                 StringBuilder_append_string(builder, CONSTANTS_COLOR_PREFIX_FALSE);
@@ -85,12 +55,12 @@ char* Literal_to_string(Literal* literal, bool color) {
     }
 
     // If Literal is negated add the negated character to string
-    if (literal->negated == true) {
+    if (negated) {
         StringBuilder_append_string(builder, CONSTANTS_NEGATE_CHAR);
     }
 
     //Add name to string
-    StringBuilder_append_string(builder, literal->generic_literal->name);
+    StringBuilder_append_string(builder, name);
 
     // If color is wanted add the default color code after the name
     if (color) {
@@ -99,3 +69,45 @@ char* Literal_to_string(Literal* literal, bool color) {
 
     return StringBuilder_destroy_to_string(builder);
 }
+
+char* Variable_to_assignment_string(char* name, LiteralAssignment assignment, bool color) {
+    assert(name != NULL);
+
+    // Create string
+    StringBuilder* builder = StringBuilder_create(10);
+
+    {
+        switch(assignment) {
+        case LiteralAssignment_TRUE:
+            if (color) {
+                StringBuilder_append_string(builder, CONSTANTS_COLOR_PREFIX_TRUE);
+                StringBuilder_append_string(builder, name);
+                StringBuilder_append_string(builder, "=true");
+                StringBuilder_append_string(builder, CONSTANTS_COLOR_SUFFIX);
+            } else {
+                StringBuilder_append_string(builder, name);
+                StringBuilder_append_string(builder, "=true");
+            }
+            break;
+        case LiteralAssignment_FALSE:
+            if (color) {
+                StringBuilder_append_string(builder, CONSTANTS_COLOR_PREFIX_FALSE);
+                StringBuilder_append_string(builder, name);
+                StringBuilder_append_string(builder, "=false");
+                StringBuilder_append_string(builder, CONSTANTS_COLOR_SUFFIX);
+            } else {
+                StringBuilder_append_string(builder, name);
+                StringBuilder_append_string(builder, "=false");
+            }
+            break;
+        case LiteralAssignment_UNSET:
+            StringBuilder_append_string(builder, name);
+            StringBuilder_append_string(builder, "=?");
+            break;
+        default:
+            assert(0);
+        }
+    }
+
+    return StringBuilder_destroy_to_string(builder);
+}
@@ -36,105 +36,70 @@ typedef enum {
 } LiteralAssignment;
 
 /**
- * Represents a Literal that can have an assignment.
-**/
-typedef struct {
-	char* name;
-	LiteralAssignment assignment;
-	int occurrences;
-} GenericLiteral;
-
-/**
- * Wrapper class for GenericLiteral, which adds the possibility of the
- * contained GenericLiteral being negated.
+ * Represents a variable that can have an assignment.
+ *
+ * Variables are dense indices starting at 0. Assignments of all Variables
+ * are kept in one array indexed by Variable and their names are only
+ * kept in a side table for output.
 **/
-typedef struct {
-    GenericLiteral* generic_literal;
-    bool negated;
-} Literal;
-
-typedef struct {
-    GenericLiteral** literals;
-    bool* assignments;
-    unsigned int size;
-} LiteralAssignmentArray;
-
-
-LiteralAssignmentArray* LiteralAssignmentArray_create(GenericLiteral** literals, bool* assignments, unsigned int size);
-
-void LiteralAssignmentArray_destroy(LiteralAssignmentArray* assignment_array);
+typedef unsigned int Variable;
 
 /**
- * Creates a new GenericLiteral.
+ * Represents a Variable which may be negated.
+ *
+ * A Literal is encoded as 2 * Variable + (negated ? 1 : 0), so Literals
+ * are dense indices as well and a Literal and its negation only differ
+ * in the lowest bit.
 **/
-GenericLiteral* GenericLiteral_create(char* name, LiteralAssignment assignment);
+typedef unsigned int Literal;
 
-/**
- * Destroys a GenericLiteral.
-**/
-void GenericLiteral_destroy(GenericLiteral* literal);
 
 /**
- * Increases the number of Clauses a Literal occurs in by one.
+ * Creates a new Literal.
 **/
-void GenericLiteral_increase_occurrences(GenericLiteral* literal);
+static inline Literal Literal_create(Variable variable, bool negated) {
+    return 2 * variable + (negated ? 1 : 0);
+}
 
-/**
- * Returns the number of Clauses a Literal occurs in.
-**/
-int GenericLiteral_get_occurrences(GenericLiteral* literal);
+static inline Variable Literal_get_variable(Literal literal) {
+    return literal >> 1;
+}
 
-/**
- * Assign Literal the given boolean value.
-**/
-void GenericLiteral_assign(GenericLiteral* literal, bool b);
+static inline bool Literal_is_negated(Literal literal) {
+    return (literal & 1) != 0;
+}
 
 /**
- * Remove assignment for Literal.
+ * Returns the negation of a Literal.
 **/
-void GenericLiteral_unassign(GenericLiteral* literal);
+static inline Literal Literal_negate(Literal literal) {
+    return literal ^ 1;
+}
 
 /**
- * Return assignment for Literal.
+ * Returns the assignment of a Literal given the assignments of all
+ * Variables taking into account whether the Literal is negated.
 **/
-LiteralAssignment GenericLiteral_get_assignment(GenericLiteral* literal);
+static inline LiteralAssignment Literal_evaluate(Literal literal, const LiteralAssignment* assignments_v) {
+    LiteralAssignment assignment = assignments_v[Literal_get_variable(literal)];
+    if (!Literal_is_negated(literal) || assignment == LiteralAssignment_UNSET) {
+        return assignment;
+    }
 
-/**
- * Returns whether two Literals are equal.
- *
- * Note: Two Literals are equal, exactly if their names are equal.
- *       It does NOT matter whether they have the same assignment or not!
-**/
-bool GenericLiteral_equals(GenericLiteral* literal1, GenericLiteral* literal2);
+    return (assignment == LiteralAssignment_TRUE) ? LiteralAssignment_FALSE : LiteralAssignment_TRUE;
+}
 
 /**
  * Represent Literal as a string.
-**/
-char* GenericLiteral_to_string(GenericLiteral* literal, bool color);
-
-/**
- * Represent Literal with its assignment as a string.
-**/
-char* GenericLiteral_to_assignment_string(GenericLiteral* literal, bool color);
-
-/**
- * Creates a new Literal.
-**/
-Literal* Literal_create(GenericLiteral* generic_literal, bool negated);
-
-/**
- * Destroys a Literal.
  *
- * This does not free the GenericLiteral contained!
+ * The name is the name of the Variable of this Literal and the assignment
+ * is the assignment of that Variable.
 **/
-void Literal_destroy(Literal* literal);
-
-Literal* Literal_clone(Literal* literal);
+char* Literal_to_string(Literal literal, char* name, LiteralAssignment assignment, bool color);
 
 /**
- * Represent Literal as a string.
+ * Represent Variable with its assignment as a string.
 **/
-char* Literal_to_string(Literal* literal, bool color);
+char* Variable_to_assignment_string(char* name, LiteralAssignment assignment, bool color);
 
 #endif
-
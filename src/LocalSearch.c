@@ -0,0 +1,345 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+
+
+#include "LocalSearch.h"
+
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+
+// Break values above this all get the probability of the largest one
+#define LOCALSEARCH_BREAKS 64
+
+// Number of flips between checks whether the search was stopped
+#define LOCALSEARCH_POLL_INTERVAL 1024
+
+/**
+ * State of a running local search.
+**/
+typedef struct {
+    // Literals of all original Clauses, stored back to back
+    unsigned int* clause_starts_v;
+    Literal* literals_v;
+    unsigned int clauses_c;
+
+    // For every Literal the indices of the Clauses containing it, stored
+    // back to back
+    unsigned int* occurrence_starts_v;
+    uint32_t* occurrences_v;
+
+    // Complete assignment (true if the Variable is true) and for every
+    // Clause the number of its Literals that are true under it
+    bool* values_v;
+    unsigned int* true_counts_v;
+
+    // Clauses without true Literals, along with the position of every
+    // Clause in that list (or UINT32_MAX), so that Clauses are added and
+    // removed in constant time
+    uint32_t* false_v;
+    unsigned int false_c;
+    uint32_t* false_positions_v;
+
+    // Best assignment so far. Only the Variables flipped since then can
+    // differ from the current assignment, they are marked and listed.
+    bool* best_v;
+    unsigned int best_c;
+    bool* changed_v;
+    Variable* changed_list_v;
+    unsigned int changed_c;
+
+    // Probability of flipping a Variable (up to a constant factor) by the
+    // number of Clauses that would become false
+    double probabilities_v[LOCALSEARCH_BREAKS];
+    double* candidates_v;
+
+    unsigned int random_state;
+} LocalSearch;
+
+
+static unsigned int LocalSearch_random(LocalSearch* search) {
+    // xorshift32
+    unsigned int x = search->random_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    search->random_state = x;
+
+    return x;
+}
+
+static inline bool LocalSearch_is_true(LocalSearch* search, Literal literal) {
+    return search->values_v[Literal_get_variable(literal)] != Literal_is_negated(literal);
+}
+
+static inline void LocalSearch_add_false(LocalSearch* search, uint32_t index) {
+    search->false_positions_v[index] = search->false_c;
+    search->false_v[search->false_c++] = index;
+}
+
+static inline void LocalSearch_remove_false(LocalSearch* search, uint32_t index) {
+    // Move the last false Clause into the gap
+    uint32_t last = search->false_v[--search->false_c];
+    unsigned int position = search->false_positions_v[index];
+    search->false_v[position] = last;
+    search->false_positions_v[last] = position;
+    search->false_positions_v[index] = UINT32_MAX;
+}
+
+/**
+ * Returns the number of Clauses that become false when the Variable is
+ * flipped, which are the ones in which its true Literal is the only true
+ * Literal.
+**/
+static unsigned int LocalSearch_break_value(LocalSearch* search, Variable variable) {
+    Literal literal = Literal_create(variable, !search->values_v[variable]);
+
+    unsigned int breaks = 0;
+    for (unsigned int o = search->occurrence_starts_v[literal]; o < search->occurrence_starts_v[literal + 1]; o++) {
+        breaks += (search->true_counts_v[search->occurrences_v[o]] == 1);
+    }
+
+    return breaks;
+}
+
+static void LocalSearch_flip(LocalSearch* search, Variable variable) {
+    Literal falsified = Literal_create(variable, !search->values_v[variable]);
+    Literal satisfied = Literal_negate(falsified);
+    search->values_v[variable] = !search->values_v[variable];
+
+    for (unsigned int o = search->occurrence_starts_v[satisfied]; o < search->occurrence_starts_v[satisfied + 1]; o++) {
+        uint32_t index = search->occurrences_v[o];
+        if (search->true_counts_v[index]++ == 0) {
+            LocalSearch_remove_false(search, index);
+        }
+    }
+    for (unsigned int o = search->occurrence_starts_v[falsified]; o < search->occurrence_starts_v[falsified + 1]; o++) {
+        uint32_t index = search->occurrences_v[o];
+        if (--search->true_counts_v[index] == 0) {
+            LocalSearch_add_false(search, index);
+        }
+    }
+
+    if (!search->changed_v[variable]) {
+        search->changed_v[variable] = true;
+        search->changed_list_v[search->changed_c++] = variable;
+    }
+}
+
+/**
+ * Makes the current assignment the best one.
+**/
+static void LocalSearch_save_best(LocalSearch* search) {
+    for (unsigned int i = 0; i < search->changed_c; i++) {
+        Variable variable = search->changed_list_v[i];
+        search->best_v[variable] = search->values_v[variable];
+        search->changed_v[variable] = false;
+    }
+    search->changed_c = 0;
+    search->best_c = search->false_c;
+}
+
+static bool LocalSearch_is_stopped(Formula* formula) {
+    if (formula->stop != NULL && atomic_load_explicit(formula->stop, memory_order_relaxed)) {
+        return true;
+    }
+
+    return formula->terminate != NULL && formula->terminate(formula->terminate_data);
+}
+
+FormulaStatus LocalSearch_run(Formula* formula, unsigned long flips_limit) {
+    assert(formula != NULL);
+
+    // An empty Clause can't be satisfied by any assignment
+    if (formula->inconsistent) {
+        return FormulaStatus_UNDECIDED;
+    }
+
+    unsigned int variables_c = formula->variables_c;
+    unsigned int literals_c = 2 * variables_c;
+
+    LocalSearch search;
+    search.clauses_c = formula->clauses->size;
+    search.random_state = formula->random_state;
+
+    // Copy the Clauses and count the occurrences of every Literal
+    search.clause_starts_v = malloc((search.clauses_c + 1) * sizeof(unsigned int));
+    search.occurrence_starts_v = calloc(literals_c + 1, sizeof(unsigned int));
+    assert(search.clause_starts_v != NULL);
+    assert(search.occurrence_starts_v != NULL);
+
+    unsigned int total_c = 0;
+    unsigned int longest_c = 0;
+    for (unsigned int i = 0; i < search.clauses_c; i++) {
+        Clause* clause = ClauseArena_get(formula->arena, formula->clauses->data[i]);
+        search.clause_starts_v[i] = total_c;
+        total_c += clause->literals_c;
+        if (clause->literals_c > longest_c) {
+            longest_c = clause->literals_c;
+        }
+        for (unsigned int p = 0; p < clause->literals_c; p++) {
+            search.occurrence_starts_v[clause->literals_v[p] + 1]++;
+        }
+    }
+    search.clause_starts_v[search.clauses_c] = total_c;
+    for (unsigned int l = 0; l < literals_c; l++) {
+        search.occurrence_starts_v[l + 1] += search.occurrence_starts_v[l];
+    }
+
+    search.literals_v = malloc(total_c * sizeof(Literal));
+    search.occurrences_v = malloc(total_c * sizeof(uint32_t));
+    unsigned int* fill_v = malloc(literals_c * sizeof(unsigned int));
+    assert(search.literals_v != NULL || total_c == 0);
+    assert(search.occurrences_v != NULL || total_c == 0);
+    assert(fill_v != NULL || literals_c == 0);
+    for (unsigned int l = 0; l < literals_c; l++) {
+        fill_v[l] = search.occurrence_starts_v[l];
+    }
+    for (unsigned int i = 0; i < search.clauses_c; i++) {
+        Clause* clause = ClauseArena_get(formula->arena, formula->clauses->data[i]);
+        for (unsigned int p = 0; p < clause->literals_c; p++) {
+            Literal literal = clause->literals_v[p];
+            search.literals_v[search.clause_starts_v[i] + p] = literal;
+            search.occurrences_v[fill_v[literal]++] = i;
+        }
+    }
+    free(fill_v);
+
+    // Random initial assignment
+    search.values_v = malloc(variables_c * sizeof(bool));
+    search.best_v = malloc(variables_c * sizeof(bool));
+    search.changed_v = calloc(variables_c, sizeof(bool));
+    search.changed_list_v = malloc(variables_c * sizeof(Variable));
+    assert(search.values_v != NULL || variables_c == 0);
+    assert(search.best_v != NULL || variables_c == 0);
+    assert(search.changed_v != NULL || variables_c == 0);
+    assert(search.changed_list_v != NULL || variables_c == 0);
+    for (Variable variable = 0; variable < variables_c; variable++) {
+        LiteralAssignment assignment = formula->assignments_v[variable];
+        if (assignment != LiteralAssignment_UNSET && formula->levels_v[variable] == 0) {
+            search.values_v[variable] = (assignment == LiteralAssignment_TRUE);
+        } else {
+            search.values_v[variable] = LocalSearch_random(&search) & 1;
+        }
+        search.best_v[variable] = search.values_v[variable];
+    }
+    search.changed_c = 0;
+
+    search.true_counts_v = malloc(search.clauses_c * sizeof(unsigned int));
+    search.false_v = malloc(search.clauses_c * sizeof(uint32_t));
+    search.false_positions_v = malloc(search.clauses_c * sizeof(uint32_t));
+    assert(search.true_counts_v != NULL || search.clauses_c == 0);
+    assert(search.false_v != NULL || search.clauses_c == 0);
+    assert(search.false_positions_v != NULL || search.clauses_c == 0);
+    search.false_c = 0;
+    for (unsigned int i = 0; i < search.clauses_c; i++) {
+        unsigned int true_c = 0;
+        for (unsigned int p = search.clause_starts_v[i]; p < search.clause_starts_v[i + 1]; p++) {
+            true_c += LocalSearch_is_true(&search, search.literals_v[p]);
+        }
+        search.true_counts_v[i] = true_c;
+        search.false_positions_v[i] = UINT32_MAX;
+        if (true_c == 0) {
+            LocalSearch_add_false(&search, i);
+        }
+    }
+    search.best_c = search.false_c;
+
+    // Base of the exponential decay that works best for random formulas
+    // with Clauses of the longest length (by the authors of probSAT)
+    double base;
+    if (longest_c <= 3) {
+        base = 2.5;
+    } else if (longest_c == 4) {
+        base = 2.85;
+    } else if (longest_c == 5) {
+        base = 3.7;
+    } else if (longest_c == 6) {
+        base = 5.1;
+    } else {
+        base = 7.4;
+    }
+    search.probabilities_v[0] = 1.0;
+    for (unsigned int b = 1; b < LOCALSEARCH_BREAKS; b++) {
+        search.probabilities_v[b] = search.probabilities_v[b - 1] / base;
+    }
+    search.candidates_v = malloc(longest_c * sizeof(double));
+    assert(search.candidates_v != NULL || longest_c == 0);
+
+    for (unsigned long flips = 0; flips < flips_limit && search.false_c > 0; flips++) {
+        if (flips % LOCALSEARCH_POLL_INTERVAL == 0 && LocalSearch_is_stopped(formula)) {
+            break;
+        }
+
+        // Clauses only become false if they have Literals, so every false
+        // Clause has a Variable to flip
+        uint32_t index = search.false_v[LocalSearch_random(&search) % search.false_c];
+        unsigned int start = search.clause_starts_v[index];
+        unsigned int length = search.clause_starts_v[index + 1] - start;
+
+        double sum = 0.0;
+        for (unsigned int p = 0; p < length; p++) {
+            unsigned int breaks = LocalSearch_break_value(&search, Literal_get_variable(search.literals_v[start + p]));
+            if (breaks >= LOCALSEARCH_BREAKS) {
+                breaks = LOCALSEARCH_BREAKS - 1;
+            }
+            search.candidates_v[p] = search.probabilities_v[breaks];
+            sum += search.candidates_v[p];
+        }
+
+        // Pick a Literal with probability proportional to its weight, the
+        // last one also takes what rounding leaves over
+        double threshold = sum * ((LocalSearch_random(&search) >> 8) / 16777216.0);
+        unsigned int choice = 0;
+        while (choice + 1 < length && threshold >= search.candidates_v[choice]) {
+            threshold -= search.candidates_v[choice];
+            choice++;
+        }
+
+        LocalSearch_flip(&search, Literal_get_variable(search.literals_v[start + choice]));
+        if (search.false_c < search.best_c) {
+            LocalSearch_save_best(&search);
+        }
+    }
+
+    // Saved phases are true for negated Literals
+    if (search.false_c <= search.best_c) {
+        LocalSearch_save_best(&search);
+    }
+    for (Variable variable = 0; variable < variables_c; variable++) {
+        formula->phases_v[variable] = !search.best_v[variable];
+    }
+    formula->random_state = search.random_state;
+    FormulaStatus result = (search.best_c == 0) ? FormulaStatus_TRUE : FormulaStatus_UNDECIDED;
+
+    free(search.clause_starts_v);
+    free(search.literals_v);
+    free(search.occurrence_starts_v);
+    free(search.occurrences_v);
+    free(search.values_v);
+    free(search.true_counts_v);
+    free(search.false_v);
+    free(search.false_positions_v);
+    free(search.best_v);
+    free(search.changed_v);
+    free(search.changed_list_v);
+    free(search.candidates_v);
+
+    return result;
+}
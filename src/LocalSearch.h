@@ -0,0 +1,47 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+
+
+#ifndef LOCALSEARCH_H
+#define LOCALSEARCH_H
+
+
+#include "Formula.h"
+
+
+/**
+ * Searches for a satisfying assignment of the original Clauses of a
+ * Formula by stochastic local search (probSAT) with at most flips_limit
+ * flips.
+ *
+ * Starts from a random complete assignment, in which Variables that are
+ * assigned on decision level 0 keep their value, and repeatedly flips a
+ * Variable of a random false Clause. Variables are chosen with a
+ * probability that decreases exponentially with the number of Clauses
+ * that would become false by the flip. Assumptions are ignored.
+ * The best assignment found (with the fewest false Clauses) is stored in
+ * the saved phases of the Formula, so a following search with
+ * DecisionPhase_SAVED tries it first. If it satisfies the Formula that
+ * search finds it without any conflict.
+ *
+ * Returns TRUE if a satisfying assignment was found and UNDECIDED
+ * otherwise or if the search was stopped.
+**/
+FormulaStatus LocalSearch_run(Formula* formula, unsigned long flips_limit);
+
+
+#endif
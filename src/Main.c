@@ -15,22 +15,118 @@
 
 
 #include "Main.h"
-#include "Parser-CNF.h"
-#include "Parser-DIMACS.h"
+#include "Batch.h"
+#include "Parser.h"
 #include "Formula.h"
 #include "Constants.h"
+#include "InputFile.h"
+#include "CubeAndConquer.h"
+#include "Enumeration.h"
+#include "LocalSearch.h"
+#include "ModelCounter.h"
+#include "Portfolio.h"
+#include "Preprocessor.h"
+#include "SplitSearch.h"
+#include "UnsatCore.h"
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <assert.h>
 
 
+/**
+ * Parses a list of Literals separated by commas or spaces, which are
+ * given by the names of their Variables and negated by a leading
+ * negating character.
+ *
+ * Returns NULL if a Variable does not exist.
+**/
+static Literal* Main_parse_assumptions(Formula* formula, const char* list, unsigned int* literals_c) {
+    // There are at most as many Literals as separators plus one
+    unsigned int capacity = 1;
+    for (const char* c = list; *c != '\0'; c++) {
+        capacity += (*c == ',' || *c == ' ');
+    }
+
+    Literal* literals_v = malloc(capacity * sizeof(Literal));
+    assert(literals_v != NULL);
+    *literals_c = 0;
+
+    char* names = strdup(list);
+    assert(names != NULL);
+    for (char* name = strtok(names, ", "); name != NULL; name = strtok(NULL, ", ")) {
+        bool negated = name[0] == CONSTANTS_CNFPARSE_NEGATE_CHAR;
+        if (negated) {
+            name++;
+        }
+
+        Variable variable;
+        if (!Formula_find_variable(formula, name, &variable)) {
+            fprintf(stderr, "Unknown variable '%s' in assumptions!\n", name);
+            free(names);
+            free(literals_v);
+            return NULL;
+        }
+        literals_v[(*literals_c)++] = Literal_create(variable, negated);
+    }
+    free(names);
+
+    return literals_v;
+}
+
+/**
+ * Returns whether the string only consists of decimal digits.
+**/
+static bool Main_is_number(const char* str) {
+    if (*str == '\0') {
+        return false;
+    }
+
+    for (; *str != '\0'; str++) {
+        if (*str < '0' || *str > '9') {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Prints that the Formula is unsatisfiable, along with the failed
+ * assumptions if there were any.
+**/
+static void Main_print_unsatisfiable(Formula* formula, unsigned int assumptions_c) {
+    printf("Formula is not satisfiable\n");
+
+    if (assumptions_c > 0) {
+        printf("Failed assumptions:");
+        for (unsigned int i = 0; i < formula->failed_c; i++) {
+            Literal literal = formula->failed_v[i];
+            if (Literal_is_negated(literal)) {
+                printf(" %c%s", CONSTANTS_CNFPARSE_NEGATE_CHAR, formula->names_v[Literal_get_variable(literal)]);
+            } else {
+                printf(" %s", formula->names_v[Literal_get_variable(literal)]);
+            }
+        }
+        printf("\n");
+    }
+}
+
 int main(int argc, char* argv[]) {
     // Print help and exit if started with "--help" or "-h"
     for (int i = 0; i < argc; i++) {
         if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
             printf("Usage:\n");
+            printf("  %s [OPTIONS...] [FILE]\n", argv[0]);
             printf("  %s [OPTIONS...] < FILE\n", argv[0]);
+            printf("  %s [OPTIONS...] --batch [FILE|DIRECTORY...]\n", argv[0]);
+            printf("\n");
+            printf("  The formula is read from FILE or from stdin if FILE is\n");
+            printf("  not given or is '-'.\n");
+            printf("  With --batch every given file and every file in the given\n");
+            printf("  directories is solved, if none are given their paths are\n");
+            printf("  read from stdin (one per line).\n");
             printf("\n");
             printf("\n");
             printf("Options:\n");
@@ -53,6 +149,78 @@ int main(int argc, char* argv[]) {
             printf("\n");
             printf("  -d --dimacs\t\tIndicate that the given formula is in DIMACS format.\n");
             printf("\n");
+            printf("     --engine=NAME\tUse NAME to search for a satisfying assignment.\n");
+            printf("  \t\t\tAvailable engines are 'dpll' (default), 'cdcl'\n");
+            printf("  \t\t\t(conflict-driven clause learning), 'components'\n");
+            printf("  \t\t\t(exact model counting with --count that caches the\n");
+            printf("  \t\t\tcounts of independent parts of the formula) and\n");
+            printf("  \t\t\t'sls' (stochastic local search, which continues\n");
+            printf("  \t\t\twith cdcl from the best assignment it found if\n");
+            printf("  \t\t\tthere is no model after the flips given by --flips).\n");
+            printf("\n");
+            printf("     --heuristic=NAME\tUse NAME to choose the next literal to assign.\n");
+            printf("  \t\t\tAvailable heuristics are 'first' (default, first\n");
+            printf("  \t\t\tunassigned literal) and 'vsids' (literal most\n");
+            printf("  \t\t\tinvolved in recent conflicts).\n");
+            printf("\n");
+            printf("     --phase=NAME\tUse NAME to choose the value of a decision.\n");
+            printf("  \t\t\tAvailable phases are 'positive' (default), 'negative',\n");
+            printf("  \t\t\t'saved' (last value of the literal) and 'random'.\n");
+            printf("\n");
+            printf("     --threads N\tRun N differently configured solvers in parallel\n");
+            printf("  \t\t\tand take the result of the first one to finish.\n");
+            printf("\n");
+            printf("     --cubes N\t\tSplit the formula into about N cubes by looking\n");
+            printf("  \t\t\tahead and solve them with the dpll engine on\n");
+            printf("  \t\t\tthe threads given by --threads.\n");
+            printf("\n");
+            printf("     --batch\t\tSolve many formulas on the threads given by\n");
+            printf("  \t\t\t--threads and print one line with result and\n");
+            printf("  \t\t\ttime per formula instead of the assignment.\n");
+            printf("\n");
+            printf("     --split\t\tLet the threads given by --threads share one dpll\n");
+            printf("  \t\t\tsearch by giving away untried branches to idle\n");
+            printf("  \t\t\tthreads.\n");
+            printf("\n");
+            printf("     --assume LITS\tSolve under the assumption that the literals in\n");
+            printf("  \t\t\tthe comma separated list LITS are true and print\n");
+            printf("  \t\t\tthe assumptions responsible if it is unsatisfiable.\n");
+            printf("  \t\t\tCan be given several times to solve the formula\n");
+            printf("  \t\t\tonce per list.\n");
+            printf("\n");
+            printf("     --enumerate [N]\tPrint all (or the first N) satisfying assignments\n");
+            printf("  \t\t\tfound by the dpll engine, one per line. Variables\n");
+            printf("  \t\t\tthat are left out can have any value.\n");
+            printf("\n");
+            printf("     --count\t\tPrint the number of models found by the dpll\n");
+            printf("  \t\t\tengine (of the first N assignments with\n");
+            printf("  \t\t\t--enumerate N).\n");
+            printf("\n");
+            printf("     --flips N\t\tFlip at most N variables in the sls engine\n");
+            printf("  \t\t\t(default 10000000).\n");
+            printf("\n");
+            printf("     --cache-size MB\tLimit the cache of the components engine to MB\n");
+            printf("  \t\t\tmegabytes (default 256).\n");
+            printf("\n");
+            printf("     --proof FILE\tWrite a DRAT proof to FILE that can be checked\n");
+            printf("  \t\t\tif the formula is not satisfiable.\n");
+            printf("\n");
+            printf("     --proof-format=NAME\tUse NAME as format of the proof.\n");
+            printf("  \t\t\tAvailable formats are 'text' (default) and 'binary'.\n");
+            printf("\n");
+            printf("     --preprocess\tSimplify the formula before searching by\n");
+            printf("  \t\t\tremoving subsumed clauses and literals, by\n");
+            printf("  \t\t\tsubstituting equivalent literals, by probing\n");
+            printf("  \t\t\tliterals and by eliminating variables whenever\n");
+            printf("  \t\t\tthis does not add clauses.\n");
+            printf("\n");
+            printf("     --core\t\tPrint the numbers (counted from 1) of clauses that\n");
+            printf("  \t\t\tare unsatisfiable on their own if the formula is not\n");
+            printf("  \t\t\tsatisfiable.\n");
+            printf("\n");
+            printf("     --mus\t\tLike --core, but leave out clauses until none of\n");
+            printf("  \t\t\tthe remaining ones can be left out.\n");
+            printf("\n");
             printf("\n");
             printf("Examples:\n");
             printf("  echo \"{A, B}, {-A, -B}, {-C}, {E, D}\" | %s --cnf\n", argv[0]);
@@ -143,7 +311,38 @@ int main(int argc, char* argv[]) {
         }
     }
 
+    // If format is set on command line we'll use that, otherwise it will
+    // be guessed from the input.
+    ParserFormat format = ParserFormat_GUESS;
+    for (int i = 0; i < argc; i++) {
+        if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--cnf") == 0) {
+            format = ParserFormat_CNF;
+        } else if (strcmp(argv[i], "-d") == 0 || strcmp(argv[i], "--dimacs") == 0) {
+            format = ParserFormat_DIMACS;
+        }
+    }
+
     // Apply options
+    FormulaEngine engine = Formula_dpll;
+    DecisionHeuristic heuristic = DecisionHeuristic_FIRST_UNSET;
+    DecisionPhase phase = DecisionPhase_POSITIVE;
+    unsigned int threads_c = 1;
+    unsigned int cubes_c = 0;
+    bool split = false;
+    bool batch = false;
+    unsigned int assume_c = 0;
+    bool enumerate = false;
+    bool count = false;
+    unsigned long solutions_limit = 0;
+    bool components = false;
+    size_t cache_limit = (size_t)256 << 20;
+    bool local_search = false;
+    unsigned long flips_limit = 10000000;
+    char* proof_path = NULL;
+    bool proof_binary = false;
+    bool core = false;
+    bool mus = false;
+    bool preprocess = false;
     for (int i = 0; i < argc; i++) {
         if (strcmp(argv[i], "--cstart") == 0) {
             if (argc == i + 1) {
@@ -193,83 +392,405 @@ int main(int argc, char* argv[]) {
             }
 
             CONSTANTS_CNFPARSE_NEGATE_CHAR = argv[i+1][0];
+        } else if (strncmp(argv[i], "--engine=", strlen("--engine=")) == 0) {
+            char* name = argv[i] + strlen("--engine=");
+
+            if (strcmp(name, "dpll") == 0) {
+                engine = Formula_dpll;
+            } else if (strcmp(name, "cdcl") == 0) {
+                engine = Formula_cdcl;
+            } else if (strcmp(name, "components") == 0) {
+                components = true;
+            } else if (strcmp(name, "sls") == 0) {
+                local_search = true;
+                engine = Formula_cdcl;
+            } else {
+                fprintf(stderr, "Unknown engine '%s'!\n", name);
+                return 1;
+            }
+        } else if (strncmp(argv[i], "--heuristic=", strlen("--heuristic=")) == 0) {
+            char* name = argv[i] + strlen("--heuristic=");
+
+            if (strcmp(name, "first") == 0) {
+                heuristic = DecisionHeuristic_FIRST_UNSET;
+            } else if (strcmp(name, "vsids") == 0) {
+                heuristic = DecisionHeuristic_VSIDS;
+            } else {
+                fprintf(stderr, "Unknown heuristic '%s'!\n", name);
+                return 1;
+            }
+        } else if (strncmp(argv[i], "--phase=", strlen("--phase=")) == 0) {
+            char* name = argv[i] + strlen("--phase=");
+
+            if (strcmp(name, "positive") == 0) {
+                phase = DecisionPhase_POSITIVE;
+            } else if (strcmp(name, "negative") == 0) {
+                phase = DecisionPhase_NEGATIVE;
+            } else if (strcmp(name, "saved") == 0) {
+                phase = DecisionPhase_SAVED;
+            } else if (strcmp(name, "random") == 0) {
+                phase = DecisionPhase_RANDOM;
+            } else {
+                fprintf(stderr, "Unknown phase '%s'!\n", name);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--threads") == 0) {
+            if (argc == i + 1) {
+                fprintf(stderr, "%s needs a parameter!\n", argv[i]);
+                return 1;
+            }
+
+            char* end;
+            long value = strtol(argv[i+1], &end, 10);
+            if (*end != '\0' || value < 1 || value > 4096) {
+                fprintf(stderr, "%s parameter has to be a number of threads!\n", argv[i]);
+                return 1;
+            }
+
+            threads_c = value;
+        } else if (strcmp(argv[i], "--cubes") == 0) {
+            if (argc == i + 1) {
+                fprintf(stderr, "%s needs a parameter!\n", argv[i]);
+                return 1;
+            }
+
+            char* end;
+            long value = strtol(argv[i+1], &end, 10);
+            if (*end != '\0' || value < 1 || value > (1L << 24)) {
+                fprintf(stderr, "%s parameter has to be a number of cubes!\n", argv[i]);
+                return 1;
+            }
+
+            cubes_c = value;
+        } else if (strcmp(argv[i], "--split") == 0) {
+            split = true;
+        } else if (strcmp(argv[i], "--batch") == 0) {
+            batch = true;
+        } else if (strcmp(argv[i], "--assume") == 0) {
+            if (argc == i + 1) {
+                fprintf(stderr, "%s needs a parameter!\n", argv[i]);
+                return 1;
+            }
+
+            assume_c++;
+        } else if (strcmp(argv[i], "--enumerate") == 0) {
+            enumerate = true;
+
+            // The limit is optional
+            if (argc > i + 1 && Main_is_number(argv[i+1])) {
+                solutions_limit = strtoul(argv[i+1], NULL, 10);
+            }
+        } else if (strcmp(argv[i], "--count") == 0) {
+            count = true;
+        } else if (strcmp(argv[i], "--flips") == 0) {
+            if (argc == i + 1) {
+                fprintf(stderr, "%s needs a parameter!\n", argv[i]);
+                return 1;
+            }
+
+            if (!Main_is_number(argv[i+1])) {
+                fprintf(stderr, "%s parameter has to be a number of flips!\n", argv[i]);
+                return 1;
+            }
+
+            flips_limit = strtoul(argv[i+1], NULL, 10);
+        } else if (strcmp(argv[i], "--cache-size") == 0) {
+            if (argc == i + 1) {
+                fprintf(stderr, "%s needs a parameter!\n", argv[i]);
+                return 1;
+            }
+
+            char* end;
+            long value = strtol(argv[i+1], &end, 10);
+            if (*end != '\0' || value < 0 || value > (1L << 20)) {
+                fprintf(stderr, "%s parameter has to be a number of megabytes!\n", argv[i]);
+                return 1;
+            }
+
+            cache_limit = (size_t)value << 20;
+        } else if (strcmp(argv[i], "--proof") == 0) {
+            if (argc == i + 1) {
+                fprintf(stderr, "%s needs a parameter!\n", argv[i]);
+                return 1;
+            }
+
+            proof_path = argv[i+1];
+        } else if (strncmp(argv[i], "--proof-format=", strlen("--proof-format=")) == 0) {
+            char* name = argv[i] + strlen("--proof-format=");
+
+            if (strcmp(name, "text") == 0) {
+                proof_binary = false;
+            } else if (strcmp(name, "binary") == 0) {
+                proof_binary = true;
+            } else {
+                fprintf(stderr, "Unknown proof format '%s'!\n", name);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--core") == 0) {
+            core = true;
+        } else if (strcmp(argv[i], "--mus") == 0) {
+            mus = true;
+        } else if (strcmp(argv[i], "--preprocess") == 0) {
+            preprocess = true;
         }
     }
 
-    // Read formula from stdin
-    char* formula_str = NULL;
-    {
-        size_t size = 0;
-        size_t filled = 0;
+    // Cubes are solved by chronological backtracking below their
+    // Literals, which only the dpll engine supports
+    if (cubes_c > 0 && engine != Formula_dpll) {
+        fprintf(stderr, "--cubes only works with the dpll engine!\n");
+        return 1;
+    }
+    if (split && engine != Formula_dpll) {
+        fprintf(stderr, "--split only works with the dpll engine!\n");
+        return 1;
+    }
+    if (split && cubes_c > 0) {
+        fprintf(stderr, "--split and --cubes can't be combined!\n");
+        return 1;
+    }
+    if (batch && (split || cubes_c > 0)) {
+        fprintf(stderr, "--batch can't be combined with --split or --cubes!\n");
+        return 1;
+    }
+    if (assume_c > 0 && (batch || split || cubes_c > 0)) {
+        fprintf(stderr, "--assume can't be combined with --batch, --split or --cubes!\n");
+        return 1;
+    }
 
-        while (!feof(stdin)) {
-            size += BUFSIZ;
+    // Models are enumerated by chronological backtracking, which only
+    // the dpll engine supports
+    if ((enumerate || count) && engine != Formula_dpll) {
+        fprintf(stderr, "--enumerate and --count only work with the dpll engine!\n");
+        return 1;
+    }
+    if (components && (!count || enumerate)) {
+        fprintf(stderr, "--engine=components only works with --count and without --enumerate!\n");
+        return 1;
+    }
+    if ((enumerate || count) && (batch || split || cubes_c > 0 || threads_c > 1)) {
+        fprintf(stderr, "--enumerate and --count can't be combined with --batch, --split, --cubes or --threads!\n");
+        return 1;
+    }
+
+    // Local search works on a single complete assignment that ignores
+    // assumptions
+    if (local_search && (batch || split || cubes_c > 0 || threads_c > 1 || assume_c > 0)) {
+        fprintf(stderr, "--engine=sls can't be combined with --batch, --split, --cubes, --threads or --assume!\n");
+        return 1;
+    }
+
+    // A proof only follows a single search of the whole Formula
+    if (proof_path != NULL && (batch || split || cubes_c > 0 || threads_c > 1 || assume_c > 0 || enumerate || count)) {
+        fprintf(stderr, "--proof can't be combined with --batch, --split, --cubes, --threads, --assume, --enumerate or --count!\n");
+        return 1;
+    }
 
-            formula_str = realloc(formula_str, size);
-            assert(formula_str != NULL);
+    // Cores are found by solving under assumptions on a single thread
+    if ((core || mus) && (batch || split || cubes_c > 0 || threads_c > 1 || assume_c > 0 || enumerate || count)) {
+        fprintf(stderr, "--core and --mus can't be combined with --batch, --split, --cubes, --threads, --assume, --enumerate or --count!\n");
+        return 1;
+    }
 
-            filled += fread(formula_str + filled, 1, size - filled - 1, stdin);
+    // Eliminated Variables can't be assumed and their removed Clauses
+    // neither keep their number nor the number of models
+    if (preprocess && (batch || assume_c > 0 || enumerate || count || core || mus)) {
+        fprintf(stderr, "--preprocess can't be combined with --batch, --assume, --enumerate, --count, --core or --mus!\n");
+        return 1;
+    }
+
+    // Find paths of input files, which are all arguments that are
+    // neither an option nor the parameter of an option.
+    // Only in batch mode more than one can be given.
+    char** paths_v = malloc(argc * sizeof(char*));
+    assert(paths_v != NULL);
+    unsigned int paths_c = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--cstart") == 0 || strcmp(argv[i], "--cend") == 0 ||
+            strcmp(argv[i], "--cdel") == 0 || strcmp(argv[i], "--cneg") == 0 ||
+            strcmp(argv[i], "--threads") == 0 || strcmp(argv[i], "--cubes") == 0 ||
+            strcmp(argv[i], "--assume") == 0 || strcmp(argv[i], "--cache-size") == 0 ||
+            strcmp(argv[i], "--proof") == 0 || strcmp(argv[i], "--flips") == 0) {
+            i++;
+            continue;
+        }
+        if (strcmp(argv[i], "--enumerate") == 0 && i + 1 < argc && Main_is_number(argv[i+1])) {
+            i++;
+            continue;
+        }
+
+        if (argv[i][0] == '-' && strcmp(argv[i], "-") != 0) {
+            continue;
         }
-        formula_str[filled] = '\0';
 
-        // Shrink buffer to minimum size required
-        size = filled + 1;
-        formula_str = realloc(formula_str, size);
-        assert(formula_str != NULL);
+        paths_v[paths_c++] = argv[i];
     }
 
-    // Decide whether formula is in dimacs format or in cnf format.
-    Formula* formula = NULL;
-    {
-        // If format is set on command line we'll use that
-        bool cnf_format = false;
-        bool dimacs_format = false;
-
-        {
-            char* cnfs[] = {"-c", "--cnf"};
-            char* dimacs[] = {"-d", "--dimacs"};
-
-            for (int i = 0; i < argc; i++) {
-                for (int p = 0; p < 2; p++) {
-                    if (strcmp(argv[i], cnfs[p]) == 0) {
-                        cnf_format = true;
-                    }
-
-                    if (strcmp(argv[i], dimacs[p]) == 0) {
-                        dimacs_format = true;
-                    }
-                }
+    if (batch) {
+        BatchOptions options;
+        options.format = format;
+        options.engine = engine;
+        options.decision_heuristic = heuristic;
+        options.decision_phase = phase;
+        options.threads_c = threads_c;
+
+        int status = Batch_run(paths_v, paths_c, &options);
+        free(paths_v);
+        return status;
+    }
+
+    char* path = (paths_c > 0) ? paths_v[0] : NULL;
+    free(paths_v);
+    if (paths_c > 1) {
+        fprintf(stderr, "Only one input file can be given!\n");
+        return 1;
+    }
+
+    // Read formula from file or stdin
+    InputFile* input = NULL;
+    if (path == NULL || strcmp(path, "-") == 0) {
+        input = InputFile_read(stdin);
+    } else {
+        input = InputFile_open(path);
+        if (input == NULL) {
+            return 1;
+        }
+    }
+
+    // Parse formula in the format set on command line
+    Formula* formula = Parser_parse_formula(input->data, input->length, format);
+    InputFile_close(input);
+    if (formula == NULL) {
+        return 1;
+    }
+
+    // Run selected engine
+    formula->decision_heuristic = heuristic;
+    formula->decision_phase = phase;
+    formula->collect_core = core || mus;
+
+    if (proof_path != NULL) {
+        formula->proof = Proof_open(proof_path, proof_binary);
+        if (formula->proof == NULL) {
+            Formula_destroy(formula);
+            return 1;
+        }
+    }
+
+    ReconstructionStack* reconstruction = NULL;
+    if (preprocess) {
+        reconstruction = ReconstructionStack_create();
+        Preprocessor_run(formula, reconstruction);
+    }
+
+    // Without assumptions the Formula is solved once, otherwise once for
+    // every list of assumptions
+    unsigned int queries_c = (assume_c > 0) ? assume_c : 1;
+    int assume_i = 0;
+    for (unsigned int query = 0; query < queries_c; query++) {
+        Literal* assumptions_v = NULL;
+        unsigned int assumptions_c = 0;
+        if (assume_c > 0) {
+            while (strcmp(argv[assume_i], "--assume") != 0) {
+                assume_i++;
+            }
+            assume_i += 2;
+
+            assumptions_v = Main_parse_assumptions(formula, argv[assume_i - 1], &assumptions_c);
+            if (assumptions_v == NULL) {
+                Formula_destroy(formula);
+                return 1;
             }
         }
+        Formula_set_assumptions(formula, assumptions_v, assumptions_c);
+        free(assumptions_v);
 
-        // If format is not set we'll try to guess it.
-        if (!dimacs_format && !cnf_format) {
-            for (unsigned int i = 0; i < strlen(formula_str); i++) {
-                if (formula_str[i] == CONSTANTS_CNFPARSE_CLAUSE_START) {
-                    cnf_format = true;
-                }
+        if (components) {
+            BigNum* models = BigNum_create(0);
+            FormulaStatus result = ModelCounter_count(formula, cache_limit, models);
+
+            // The assumptions responsible are not collected
+            if (result == FormulaStatus_FALSE) {
+                Main_print_unsatisfiable(formula, 0);
             }
+            char* str = BigNum_to_string(models);
+            printf("Number of models: %s\n", str);
+            free(str);
+
+            BigNum_destroy(models);
+            continue;
+        }
+
+        if (enumerate || count) {
+            BigNum* models = BigNum_create(0);
+            FormulaStatus result = Enumeration_run(formula, solutions_limit, enumerate ? stdout : NULL, models);
+
+            if (result == FormulaStatus_FALSE && models->limbs_c == 0) {
+                Main_print_unsatisfiable(formula, assumptions_c);
+            }
+            if (count) {
+                char* str = BigNum_to_string(models);
+                printf("Number of models: %s\n", str);
+                free(str);
+            }
+
+            BigNum_destroy(models);
+            continue;
         }
 
-        if (cnf_format) {
-            formula = CNFParser_parse_formula(formula_str);
+        FormulaStatus result;
+        if (cubes_c > 0) {
+            result = CubeAndConquer_solve(formula, cubes_c, threads_c);
+        } else if (split) {
+            result = SplitSearch_solve(formula, threads_c);
+        } else if (threads_c > 1) {
+            result = Portfolio_solve(formula, engine, threads_c);
         } else {
-            formula = DIMACSParser_parse_formula(formula_str);
+            // The systematic search starts from the best assignment of the
+            // local search, which it reproduces without conflicts if it is
+            // a model
+            if (local_search) {
+                LocalSearch_run(formula, flips_limit);
+                formula->decision_phase = DecisionPhase_SAVED;
+            }
+            result = engine(formula);
+        }
+
+        if (result == FormulaStatus_FALSE) {
+            Main_print_unsatisfiable(formula, assumptions_c);
+
+            if (core || mus) {
+                unsigned int core_c;
+                unsigned int* core_v = UnsatCore_collect(formula, &core_c);
+                if (mus) {
+                    UnsatCore_minimize(formula, engine, core_v, &core_c);
+                }
+
+                printf("%s:", mus ? "Minimal unsatisfiable core" : "Unsatisfiable core");
+                for (unsigned int i = 0; i < core_c; i++) {
+                    printf(" %u", core_v[i] + 1);
+                }
+                printf("\n");
+                free(core_v);
+            }
+        } else {
+            if (reconstruction != NULL) {
+                ReconstructionStack_extend_model(reconstruction, formula);
+            }
+
+            char* str = Formula_to_assignment_string(formula, true, CONSTANTS_COLOR_ENABLED);
+            printf("%s\n", str);
+            free(str);
         }
     }
-    free(formula_str);
-    if (formula == NULL) {
-        return 1;
+
+    if (reconstruction != NULL) {
+        ReconstructionStack_destroy(reconstruction);
     }
 
-    // Run DPLL
-    bool satisfiable = Formula_dpll(formula);
-    if (!satisfiable) {
-        printf("Formula is not satisfiable\n");
-    } else {
-        char* str = Formula_to_assignment_string(formula, true, CONSTANTS_COLOR_ENABLED);
-        printf("%s\n", str);
-        free(str);
+    if (formula->proof != NULL && !Proof_close(formula->proof)) {
+        Formula_destroy(formula);
+        return 1;
     }
 
     Formula_destroy(formula);
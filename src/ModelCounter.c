@@ -0,0 +1,359 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+
+
+#include "ModelCounter.h"
+#include "ComponentCache.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+
+/**
+ * State of a running count.
+**/
+typedef struct {
+    Formula* formula;
+
+    // For every Variable the indices of the original Clauses containing
+    // it, stored back to back
+    unsigned int* occurrence_starts_v;
+    uint32_t* occurrences_v;
+
+    // Marks of Variables and Clauses already put into a component
+    unsigned int* variable_stamps_v;
+    unsigned int* clause_stamps_v;
+    unsigned int stamp;
+
+    // Number of open Clauses containing a Variable, used for choosing
+    // the Variable to branch on
+    unsigned int* scores_v;
+
+    ComponentCache* cache;
+} ModelCounter;
+
+
+static int ModelCounter_compare(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*) a;
+    uint32_t y = *(const uint32_t*) b;
+    return (x > y) - (x < y);
+}
+
+static BigNum* ModelCounter_count_component(ModelCounter* counter, uint32_t* variables_v, unsigned int variables_c,
+                                            uint32_t* clauses_v, unsigned int clauses_c);
+
+/**
+ * Multiplies count by the number of models of the open Clauses over the
+ * unassigned ones of the given Variables.
+**/
+static void ModelCounter_count_residual(ModelCounter* counter, const uint32_t* variables_v, unsigned int variables_c,
+                                        BigNum* count) {
+    Formula* formula = counter->formula;
+
+    // Variables and Clauses of all components back to back
+    uint32_t* component_variables_v = malloc(variables_c * sizeof(uint32_t));
+    unsigned int* variable_ends_v = malloc(variables_c * sizeof(unsigned int));
+    unsigned int* clause_ends_v = malloc(variables_c * sizeof(unsigned int));
+    assert(component_variables_v != NULL || variables_c == 0);
+    assert(variable_ends_v != NULL || variables_c == 0);
+    assert(clause_ends_v != NULL || variables_c == 0);
+    unsigned int component_variables_c = 0;
+    unsigned int components_c = 0;
+
+    unsigned int clauses_capacity = 16;
+    uint32_t* component_clauses_v = malloc(clauses_capacity * sizeof(uint32_t));
+    assert(component_clauses_v != NULL);
+    unsigned int component_clauses_c = 0;
+
+    // Unassigned Variables that are in no open Clause can have any value
+    unsigned int free_c = 0;
+
+    // Collect every component by a breadth-first search over the open
+    // Clauses before counting any of them, as counting changes the marks
+    counter->stamp++;
+    for (unsigned int i = 0; i < variables_c; i++) {
+        Variable start = variables_v[i];
+        if (formula->assignments_v[start] != LiteralAssignment_UNSET ||
+            counter->variable_stamps_v[start] == counter->stamp) {
+            continue;
+        }
+
+        unsigned int head = component_variables_c;
+        unsigned int clauses_start = component_clauses_c;
+        counter->variable_stamps_v[start] = counter->stamp;
+        component_variables_v[component_variables_c++] = start;
+
+        while (head < component_variables_c) {
+            Variable variable = component_variables_v[head++];
+
+            for (unsigned int o = counter->occurrence_starts_v[variable];
+                 o < counter->occurrence_starts_v[variable + 1]; o++) {
+                uint32_t index = counter->occurrences_v[o];
+                Clause* clause = ClauseArena_get(formula->arena, formula->clauses->data[index]);
+                if (clause->clause_status != ClauseStatus_UNDECIDED || counter->clause_stamps_v[index] == counter->stamp) {
+                    continue;
+                }
+
+                counter->clause_stamps_v[index] = counter->stamp;
+                if (component_clauses_c == clauses_capacity) {
+                    clauses_capacity *= 2;
+                    component_clauses_v = realloc(component_clauses_v, clauses_capacity * sizeof(uint32_t));
+                    assert(component_clauses_v != NULL);
+                }
+                component_clauses_v[component_clauses_c++] = index;
+
+                for (unsigned int p = 0; p < clause->literals_c; p++) {
+                    Variable other = Literal_get_variable(clause->literals_v[p]);
+                    if (formula->assignments_v[other] == LiteralAssignment_UNSET &&
+                        counter->variable_stamps_v[other] != counter->stamp) {
+                        counter->variable_stamps_v[other] = counter->stamp;
+                        component_variables_v[component_variables_c++] = other;
+                    }
+                }
+            }
+        }
+
+        if (component_clauses_c == clauses_start) {
+            // A single Variable without open Clauses
+            component_variables_c--;
+            free_c++;
+        } else {
+            variable_ends_v[components_c] = component_variables_c;
+            clause_ends_v[components_c] = component_clauses_c;
+            components_c++;
+        }
+    }
+
+    unsigned int variables_start = 0;
+    unsigned int clauses_start = 0;
+    for (unsigned int c = 0; c < components_c; c++) {
+        // Sorted Variables and Clauses identify the component in the
+        // cache regardless of the order they were found in
+        uint32_t* component_v = component_variables_v + variables_start;
+        unsigned int component_c = variable_ends_v[c] - variables_start;
+        uint32_t* clauses_v = component_clauses_v + clauses_start;
+        unsigned int clauses_c = clause_ends_v[c] - clauses_start;
+        qsort(component_v, component_c, sizeof(uint32_t), ModelCounter_compare);
+        qsort(clauses_v, clauses_c, sizeof(uint32_t), ModelCounter_compare);
+
+        BigNum* component_count = ModelCounter_count_component(counter, component_v, component_c, clauses_v, clauses_c);
+        BigNum_multiply(count, component_count);
+        BigNum_destroy(component_count);
+
+        // No need to count the other components if one has no models
+        if (BigNum_is_zero(count)) {
+            break;
+        }
+
+        variables_start = variable_ends_v[c];
+        clauses_start = clause_ends_v[c];
+    }
+
+    BigNum_shift_left(count, free_c);
+
+    free(component_variables_v);
+    free(variable_ends_v);
+    free(clause_ends_v);
+    free(component_clauses_v);
+}
+
+/**
+ * Returns the number of models of a component given by its sorted
+ * Variables and open Clauses.
+**/
+static BigNum* ModelCounter_count_component(ModelCounter* counter, uint32_t* variables_v, unsigned int variables_c,
+                                            uint32_t* clauses_v, unsigned int clauses_c) {
+    Formula* formula = counter->formula;
+
+    // The open Clauses of a component only consist of its Variables, so
+    // both together determine its models
+    unsigned int key_c = 1 + variables_c + clauses_c;
+    uint32_t* key_v = malloc(key_c * sizeof(uint32_t));
+    assert(key_v != NULL);
+    key_v[0] = variables_c;
+    for (unsigned int i = 0; i < variables_c; i++) {
+        key_v[1 + i] = variables_v[i];
+    }
+    for (unsigned int i = 0; i < clauses_c; i++) {
+        key_v[1 + variables_c + i] = clauses_v[i];
+    }
+
+    const BigNum* cached = ComponentCache_lookup(counter->cache, key_v, key_c);
+    if (cached != NULL) {
+        free(key_v);
+        return BigNum_copy(cached);
+    }
+
+    // Branch on the Variable in most open Clauses of the component
+    for (unsigned int i = 0; i < clauses_c; i++) {
+        Clause* clause = ClauseArena_get(formula->arena, formula->clauses->data[clauses_v[i]]);
+        for (unsigned int p = 0; p < clause->literals_c; p++) {
+            counter->scores_v[Literal_get_variable(clause->literals_v[p])]++;
+        }
+    }
+
+    Variable branch = variables_v[0];
+    for (unsigned int i = 0; i < variables_c; i++) {
+        if (counter->scores_v[variables_v[i]] > counter->scores_v[branch]) {
+            branch = variables_v[i];
+        }
+    }
+
+    for (unsigned int i = 0; i < clauses_c; i++) {
+        Clause* clause = ClauseArena_get(formula->arena, formula->clauses->data[clauses_v[i]]);
+        for (unsigned int p = 0; p < clause->literals_c; p++) {
+            counter->scores_v[Literal_get_variable(clause->literals_v[p])] = 0;
+        }
+    }
+
+    BigNum* count = BigNum_create(0);
+    unsigned int level = formula->decision_level;
+    for (unsigned int phase = 0; phase < 2; phase++) {
+        Formula_decide(formula, Literal_create(branch, phase == 1));
+
+        if (Formula_unit_propagate(formula) == CLAUSEREF_UNDEF) {
+            BigNum* branch_count = BigNum_create(1);
+            ModelCounter_count_residual(counter, variables_v, variables_c, branch_count);
+            BigNum_add(count, branch_count);
+            BigNum_destroy(branch_count);
+        }
+
+        Formula_backtrack_to_level(formula, level);
+    }
+
+    ComponentCache_store(counter->cache, key_v, key_c, count);
+    free(key_v);
+
+    return count;
+}
+
+/**
+ * Assigns the assumptions and everything they imply.
+ *
+ * Returns false if they contradict each other or the Formula.
+**/
+static bool ModelCounter_assume(Formula* formula) {
+    for (unsigned int i = 0; i < formula->assumptions_c; i++) {
+        Literal assumption = formula->assumptions_v[i];
+
+        switch (Formula_get_assignment(formula, assumption)) {
+            case LiteralAssignment_TRUE:
+                break;
+            case LiteralAssignment_FALSE:
+                return false;
+            case LiteralAssignment_UNSET:
+                Formula_decide(formula, assumption);
+                if (Formula_unit_propagate(formula) != CLAUSEREF_UNDEF) {
+                    return false;
+                }
+                break;
+        }
+    }
+
+    return true;
+}
+
+FormulaStatus ModelCounter_count(Formula* formula, size_t cache_limit, BigNum* models) {
+    assert(formula != NULL);
+    assert(models != NULL);
+    assert(formula->learned_clauses->size == 0);
+
+    // Start over if the Formula was searched before
+    Formula_backtrack_to_level(formula, 0);
+    formula->failed_c = 0;
+
+    if (formula->inconsistent) {
+        return FormulaStatus_FALSE;
+    }
+
+    // Open Clauses are told apart by their status
+    Formula_track_clause_status(formula);
+    if (Formula_unit_propagate(formula) != CLAUSEREF_UNDEF) {
+        formula->inconsistent = true;
+        return FormulaStatus_FALSE;
+    }
+
+    if (!ModelCounter_assume(formula)) {
+        Formula_backtrack_to_level(formula, 0);
+        return FormulaStatus_FALSE;
+    }
+
+    ModelCounter counter;
+    counter.formula = formula;
+    counter.stamp = 0;
+    counter.cache = ComponentCache_create(cache_limit);
+
+    unsigned int variables_c = formula->variables_c;
+    unsigned int clauses_c = formula->clauses->size;
+    counter.occurrence_starts_v = calloc(variables_c + 1, sizeof(unsigned int));
+    counter.variable_stamps_v = calloc(variables_c, sizeof(unsigned int));
+    counter.clause_stamps_v = calloc(clauses_c, sizeof(unsigned int));
+    counter.scores_v = calloc(variables_c, sizeof(unsigned int));
+    assert(counter.occurrence_starts_v != NULL);
+    assert(counter.variable_stamps_v != NULL || variables_c == 0);
+    assert(counter.clause_stamps_v != NULL || clauses_c == 0);
+    assert(counter.scores_v != NULL || variables_c == 0);
+
+    // Build occurrence lists of Variables by counting them first
+    for (unsigned int c = 0; c < clauses_c; c++) {
+        Clause* clause = ClauseArena_get(formula->arena, formula->clauses->data[c]);
+        for (unsigned int p = 0; p < clause->literals_c; p++) {
+            counter.occurrence_starts_v[Literal_get_variable(clause->literals_v[p]) + 1]++;
+        }
+    }
+    for (unsigned int v = 0; v < variables_c; v++) {
+        counter.occurrence_starts_v[v + 1] += counter.occurrence_starts_v[v];
+    }
+
+    counter.occurrences_v = malloc(counter.occurrence_starts_v[variables_c] * sizeof(uint32_t));
+    assert(counter.occurrences_v != NULL || counter.occurrence_starts_v[variables_c] == 0);
+    for (unsigned int c = 0; c < clauses_c; c++) {
+        Clause* clause = ClauseArena_get(formula->arena, formula->clauses->data[c]);
+        for (unsigned int p = 0; p < clause->literals_c; p++) {
+            Variable variable = Literal_get_variable(clause->literals_v[p]);
+            counter.occurrences_v[counter.occurrence_starts_v[variable] + counter.scores_v[variable]++] = c;
+        }
+    }
+    for (unsigned int v = 0; v < variables_c; v++) {
+        counter.scores_v[v] = 0;
+    }
+
+    uint32_t* variables_v = malloc(variables_c * sizeof(uint32_t));
+    assert(variables_v != NULL || variables_c == 0);
+    for (unsigned int v = 0; v < variables_c; v++) {
+        variables_v[v] = v;
+    }
+
+    BigNum* count = BigNum_create(1);
+    ModelCounter_count_residual(&counter, variables_v, variables_c, count);
+    BigNum_add(models, count);
+
+    FormulaStatus result = BigNum_is_zero(count) ? FormulaStatus_FALSE : FormulaStatus_TRUE;
+
+    BigNum_destroy(count);
+    free(variables_v);
+    free(counter.occurrences_v);
+    free(counter.occurrence_starts_v);
+    free(counter.variable_stamps_v);
+    free(counter.clause_stamps_v);
+    free(counter.scores_v);
+    ComponentCache_destroy(counter.cache);
+
+    Formula_backtrack_to_level(formula, 0);
+    return result;
+}
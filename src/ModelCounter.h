@@ -0,0 +1,45 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+
+
+#ifndef MODELCOUNTER_H
+#define MODELCOUNTER_H
+
+
+#include "BigNum.h"
+#include "Formula.h"
+
+#include <stddef.h>
+
+
+/**
+ * Counts the models of a Formula (under its assumptions) exactly without
+ * enumerating them.
+ *
+ * After every decision the open Clauses are split into components that
+ * share no unassigned Variables, whose counts are multiplied. The count
+ * of every component is kept in a cache of at most cache_limit bytes, so
+ * that components which come up again in other branches are only counted
+ * once. The Formula must not contain learned Clauses.
+ * The number of models is added to models.
+ *
+ * Returns TRUE if there is a model and FALSE otherwise.
+**/
+FormulaStatus ModelCounter_count(Formula* formula, size_t cache_limit, BigNum* models);
+
+
+#endif
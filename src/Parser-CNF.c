@@ -14,170 +14,138 @@
 **/
 
 
+
+
 #include "Parser-CNF.h"
+#include "ClauseArena.h"
+#include "ClauseRefVector.h"
 #include "Constants.h"
-#include "StringBuilder.h"
+#include "StringTable.h"
 
 #include <assert.h>
+#include <ctype.h>
 #include <string.h>
 
 
-Formula* CNFParser_parse_formula(char* formula_str) {
-    assert(formula_str != NULL);
-
-    // Create list of Clauses
-    LinkedList* clause_list = LinkedList_create((void (*)(void*))&Clause_destroy);
-
-    // Create list of ALL Literals
-    LinkedList* all_literals = LinkedList_create((void (*)(void*))&GenericLiteral_destroy);
-
-    // Search for starting point of Clause
-    for (unsigned int i = 0; i < strlen(formula_str); i++) {
-        char c = formula_str[i];
-        if (c == CONSTANTS_CNFPARSE_CLAUSE_START) {
-            // Create string containing the Clause
-            StringBuilder* clause_str_builder = StringBuilder_create(30);
-
-            // Search end of Clause and add everything between
-            // start and end to the Clause-String
-            unsigned int p;
-            for (p = i+1; p < strlen(formula_str); p++) {
-                if (formula_str[p] != CONSTANTS_CNFPARSE_CLAUSE_END) {
-                    StringBuilder_append_char(clause_str_builder, formula_str[p]);
-                } else {
-                    break;
-                }
-            }
-            i = p;
-
-            // Create new Clause from string
-            char* clause_str = StringBuilder_destroy_to_string(clause_str_builder);
-            Clause* new_clause = CNFParser_parse_clause(clause_str, all_literals);
-            free(clause_str);
+/**
+ * States of the tokenizer.
+ *
+ * OUTSIDE_CLAUSE - Looking for the start of the next Clause
+ * INSIDE_CLAUSE - Reading Literals of a Clause
+**/
+typedef enum {
+    CNFParserState_OUTSIDE_CLAUSE,
+    CNFParserState_INSIDE_CLAUSE
+} CNFParserState;
 
-            // Add new Clause to list
-            LinkedList_append(clause_list, new_clause);
+/**
+ * Literals of the Clause and name of the Literal that are currently read.
+**/
+typedef struct {
+    Literal* literals_v;
+    unsigned int literals_c;
+    unsigned int literals_capacity;
+
+    char* name;
+    size_t name_length;
+    size_t name_capacity;
+    bool negated;
+} CNFParserClause;
+
+
+static void CNFParser_finish_literal(CNFParserClause* clause, StringTable* names) {
+    // Ignore Literals without name
+    if (clause->name_length > 0) {
+        unsigned int variable = StringTable_intern(names, clause->name, clause->name_length);
+
+        // Resize if necessary
+        if (clause->literals_c == clause->literals_capacity) {
+            clause->literals_capacity *= 2;
+            clause->literals_v = realloc(clause->literals_v, clause->literals_capacity * sizeof(Literal));
+            assert(clause->literals_v != NULL);
         }
 
+        clause->literals_v[clause->literals_c++] = Literal_create(variable, clause->negated);
     }
 
-    // Convert list of all literals to array
-    int all_literals_c = all_literals->size;
-    GenericLiteral** all_literals_v = malloc(all_literals_c * sizeof(GenericLiteral*));
-    {
-        int i = 0;
-        for (LinkedListNode* iter = all_literals->head; iter != NULL; iter = iter->next) {
-            GenericLiteral* lit = iter->data;
-
-            all_literals_v[i] = lit;
-
-            i++;
-        }
-    }
-    LinkedList_destroy(all_literals, false);
-
-    // Create Formula from list of Clauses and array of all Literals
-    Formula* formula = Formula_create(clause_list, all_literals_v, all_literals_c);
-
-    return formula;
+    clause->name_length = 0;
+    clause->negated = false;
 }
 
-Clause* CNFParser_parse_clause(char* clause_str, LinkedList* all_literals) {
-    assert(clause_str != NULL);
-    assert(all_literals != NULL);
-
-    // Create list of all Literals contained in this Clause
-    LinkedList* clause_literals = LinkedList_create((void(*)(void*))Literal_destroy);
-
-    // Create a Literal string
-    StringBuilder* lit_str_builder = StringBuilder_create(10);
-
-    for (unsigned int i = 0; i < strlen(clause_str); i++) {
-        char c = clause_str[i];
-
-        if (c != CONSTANTS_CNFPARSE_LITERAL_DELIMITER) {
-            StringBuilder_append_char(lit_str_builder, c);
-        }
-
-        if (c == CONSTANTS_CNFPARSE_LITERAL_DELIMITER || i+1 == strlen(clause_str)) {
-            // Create new Literal from Literal string
-            char* lit_str = StringBuilder_destroy_to_string(lit_str_builder);
-            Literal* new_literal = CNFParser_parse_literal(lit_str, all_literals);
-            free(lit_str);
-            lit_str_builder = StringBuilder_create(10);
-
-            // Add new Literal to list
-            LinkedList_append(clause_literals, new_literal);
-        }
+static inline void CNFParser_append_name_char(CNFParserClause* clause, char c) {
+    // Resize if necessary
+    if (clause->name_length == clause->name_capacity) {
+        clause->name_capacity *= 2;
+        clause->name = realloc(clause->name, clause->name_capacity);
+        assert(clause->name != NULL);
     }
-    StringBuilder_destroy(lit_str_builder);
-
-    // Create array of Literals from list of Literals
-    unsigned int literals_c = clause_literals->size;
-    Literal** literals_v = malloc(sizeof(Literal*) * literals_c);
-    {
-        int i = 0;
-        for (LinkedListNode* iter = clause_literals->head; iter != NULL; iter = iter->next) {
-            literals_v[i] = iter->data;
-            i++;
-        }
-    }
-    LinkedList_destroy(clause_literals, false);
 
-    // Create Clause from list of Literals
-    Clause* new_clause = Clause_create(literals_v, literals_c);
-    return new_clause;
+    clause->name[clause->name_length++] = c;
 }
 
-Literal* CNFParser_parse_literal(char* literal_str, LinkedList* all_literals) {
-    assert(literal_str != NULL);
-    assert(all_literals != NULL);
-
-    // Create name string
-    StringBuilder* name_builder = StringBuilder_create(10);
-
-    bool negated = false;
-
-    // Look for Literal name and check if it is negated
-    for (unsigned int i = 0; i < strlen(literal_str); i++) {
-        char c = literal_str[i];
+Formula* CNFParser_parse_formula(const char* formula_str, size_t length) {
+    assert(formula_str != NULL || length == 0);
+
+    // Create storage and list of Clauses
+    ClauseArena* arena = ClauseArena_create(length);
+    ClauseRefVector* clause_list = ClauseRefVector_create(16);
+
+    // Numbers of all Variables by name
+    StringTable* names = StringTable_create(64);
+
+    // Buffers for the current Clause, reused for all Clauses
+    CNFParserClause clause;
+    clause.literals_c = 0;
+    clause.literals_capacity = 16;
+    clause.literals_v = malloc(clause.literals_capacity * sizeof(Literal));
+    clause.name_length = 0;
+    clause.name_capacity = 16;
+    clause.name = malloc(clause.name_capacity);
+    clause.negated = false;
+    assert(clause.literals_v != NULL);
+    assert(clause.name != NULL);
+
+    // Read input exactly once
+    CNFParserState state = CNFParserState_OUTSIDE_CLAUSE;
+    for (size_t i = 0; i < length; i++) {
+        char c = formula_str[i];
 
-        if (c == CONSTANTS_CNFPARSE_NEGATE_CHAR) {
-            negated = !negated;
-        } else if (c == ' ') {
-            // skip
-        } else {
-            StringBuilder_append_char(name_builder, c);
+        if (state == CNFParserState_OUTSIDE_CLAUSE) {
+            // Everything outside of Clauses is ignored
+            if (c == CONSTANTS_CNFPARSE_CLAUSE_START) {
+                state = CNFParserState_INSIDE_CLAUSE;
+            }
+        } else if (c == CONSTANTS_CNFPARSE_CLAUSE_END) {
+            CNFParser_finish_literal(&clause, names);
+
+            // Store Clause in arena
+            ClauseRef new_clause = ClauseArena_add(arena, clause.literals_v, clause.literals_c, false);
+            ClauseRefVector_append(clause_list, new_clause);
+            clause.literals_c = 0;
+
+            state = CNFParserState_OUTSIDE_CLAUSE;
+        } else if (c == CONSTANTS_CNFPARSE_LITERAL_DELIMITER) {
+            CNFParser_finish_literal(&clause, names);
+        } else if (c == CONSTANTS_CNFPARSE_NEGATE_CHAR) {
+            clause.negated = !clause.negated;
+        } else if (!isspace((unsigned char)c)) {
+            CNFParser_append_name_char(&clause, c);
         }
     }
-    char* name = StringBuilder_destroy_to_string(name_builder);
-
-    // Create new GenericLiteral
-    GenericLiteral* new_literal = GenericLiteral_create(name, LiteralAssignment_UNSET);
 
-    // Check if Literal is already contained in list of all Literals
-    // If it is take that one, if not create a new one and add it to
-    // the list of all Literals.
-    bool literal_already_contained = false;
-    for (LinkedListNode* iter = all_literals->head; iter != NULL; iter = iter->next) {
-        GenericLiteral* found_literal = iter->data;
+    // The last Clause ends with the input if it is not closed
+    if (state == CNFParserState_INSIDE_CLAUSE) {
+        CNFParser_finish_literal(&clause, names);
 
-        if (GenericLiteral_equals(found_literal, new_literal)) {
-            GenericLiteral_destroy(new_literal);
-
-            new_literal = found_literal;
-            literal_already_contained = true;
-            break;
-        }
+        ClauseRef new_clause = ClauseArena_add(arena, clause.literals_v, clause.literals_c, false);
+        ClauseRefVector_append(clause_list, new_clause);
     }
+    free(clause.literals_v);
+    free(clause.name);
 
-    if (!literal_already_contained) {
-        LinkedList_append(all_literals, new_literal);
-    }
+    // Create Formula from list of Clauses, which keeps the table to find
+    // Variables by name
+    Formula* formula = Formula_create_named(arena, clause_list, names);
 
-    // Create new Literal
-    Literal* literal = Literal_create(new_literal, negated);
-    GenericLiteral_increase_occurrences(new_literal);
-
-    return literal;
+    return formula;
 }
@@ -14,19 +14,25 @@
 **/
 
 
+
+
 #ifndef PARSER_CNF_H
 #define PARSER_CNF_H
 
 
-#include "Literal.h"
-#include "Clause.h"
 #include "Formula.h"
 
+#include <stddef.h>
 
-Formula* CNFParser_parse_formula(char* str);
-
-Clause* CNFParser_parse_clause(char* clause_str, LinkedList* all_literals);
 
-Literal* CNFParser_parse_literal(char* literal_str, LinkedList* all_literals);
+/**
+ * Parses a Formula in CNF format.
+ *
+ * Everything between the end of a Clause and the start of the next one
+ * is ignored. Names of Literals may consist of any characters except the
+ * special characters of the format, whitespace inside names is ignored.
+ * The input does not have to be terminated by '\0'.
+**/
+Formula* CNFParser_parse_formula(const char* str, size_t length);
 
 #endif
@@ -14,52 +14,116 @@
 **/
 
 
+
+
 #include "Parser-DIMACS.h"
-#include "LinkedList.h"
-#include "StringBuilder.h"
+#include "ClauseArena.h"
+#include "ClauseRefVector.h"
 
+#include <assert.h>
+#include <limits.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 
 
-Formula* DIMACSParser_parse_formula(char* str) {
-    // Split string into array of lines
-    unsigned int lines_c = 10;
-    char** lines_v = malloc(lines_c * sizeof(char*));
-    {
-        unsigned int lines_filled = 0;
-
-        char* tmp = strtok(str, "\n");
-        while (tmp != NULL) {
-            // Resize if necessary
-            if (lines_filled + 1 > lines_c) {
-                lines_c *= 4;
-                lines_v = realloc(lines_v, lines_c * sizeof(char*));
-            }
+/**
+ * Current position of the tokenizer in the input.
+**/
+typedef struct {
+    const char* pos;
+    const char* end;
+} DIMACSParserInput;
+
 
-            // Add to array
-            lines_v[lines_filled++] = tmp;
+static inline bool DIMACSParser_is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
 
-            // Split off next line from string
-            tmp = strtok(NULL, "\n");
+/**
+ * Skips whitespace and comment lines.
+ *
+ * If stop_at_newline is true this only skips whitespace up to the end of
+ * the current line.
+**/
+static void DIMACSParser_skip(DIMACSParserInput* input, bool stop_at_newline) {
+    while (input->pos < input->end) {
+        char c = *input->pos;
+
+        if (c == '\n' && stop_at_newline) {
+            return;
+        } else if (DIMACSParser_is_space(c)) {
+            input->pos++;
+        } else if (c == 'c' && !stop_at_newline) {
+            // Skip comment until end of line
+            const char* newline = memchr(input->pos, '\n', input->end - input->pos);
+            input->pos = (newline != NULL) ? newline : input->end;
+        } else {
+            return;
         }
+    }
+}
 
-        // Shrink array to minimum size required
-        lines_c = lines_filled;
-        lines_v = realloc(lines_v, lines_c * sizeof(char*));
+/**
+ * Reads the word at the current position.
+ *
+ * Returns the length of the word.
+**/
+static size_t DIMACSParser_read_word(DIMACSParserInput* input, const char** word) {
+    *word = input->pos;
+    while (input->pos < input->end && !DIMACSParser_is_space(*input->pos)) {
+        input->pos++;
     }
 
-    // Skip first lines with comments
-    unsigned int linec = 0;
-    for (linec = 0; linec < lines_c; linec++) {
-        if (lines_v[linec][0] == 'c') {
-            // skip
-        } else {
-            break;
+    return input->pos - *word;
+}
+
+/**
+ * Parses the decimal integer at the current position.
+ *
+ * Returns false if there is no valid integer.
+**/
+static bool DIMACSParser_read_int(DIMACSParserInput* input, long* value) {
+    const char* pos = input->pos;
+
+    bool negative = false;
+    if (pos < input->end && *pos == '-') {
+        negative = true;
+        pos++;
+    }
+
+    // Need at least one digit
+    if (pos == input->end || *pos < '0' || *pos > '9') {
+        return false;
+    }
+
+    long result = 0;
+    while (pos < input->end && *pos >= '0' && *pos <= '9') {
+        result = result * 10 + (*pos - '0');
+        if (result > INT_MAX) {
+            return false;
         }
+        pos++;
+    }
+
+    // Integer has to end with whitespace
+    if (pos < input->end && !DIMACSParser_is_space(*pos)) {
+        return false;
     }
 
+    input->pos = pos;
+    *value = negative ? -result : result;
+    return true;
+}
+
+Formula* DIMACSParser_parse_formula(const char* str, size_t length) {
+    assert(str != NULL || length == 0);
+
+    DIMACSParserInput input = { str, str + length };
+
+    // Skip first lines with comments
+    DIMACSParser_skip(&input, false);
+
     unsigned int literals_count = 0;
     unsigned int clauses_count = 0;
 
@@ -73,20 +137,38 @@ Formula* DIMACSParser_parse_formula(char* str) {
         // <Number of Literals>
         // <Number of Clauses>
         int i = 0;
-        char* tmp = strtok(lines_v[linec], " ");
-        while (tmp != NULL) {
-            if (i == 0 && strcmp(tmp, "p") != 0) {
-                problem_line_error = true;
-            } else if (i == 1 && strcmp(tmp, "cnf") != 0) {
+        while (true) {
+            DIMACSParser_skip(&input, true);
+            if (input.pos == input.end || *input.pos == '\n') {
+                break;
+            }
+
+            const char* word;
+            size_t word_length;
+            long value;
+
+            if (i == 0) {
+                word_length = DIMACSParser_read_word(&input, &word);
+                if (word_length != 1 || strncmp(word, "p", 1) != 0) {
+                    problem_line_error = true;
+                }
+            } else if (i == 1) {
+                word_length = DIMACSParser_read_word(&input, &word);
+                if (word_length != 3 || strncmp(word, "cnf", 3) != 0) {
+                    problem_line_error = true;
+                }
+            } else if ((i == 2 || i == 3) && DIMACSParser_read_int(&input, &value) && value >= 0) {
+                if (i == 2) {
+                    literals_count = value;
+                } else {
+                    clauses_count = value;
+                }
+            } else {
+                DIMACSParser_read_word(&input, &word);
                 problem_line_error = true;
-            } else if (i == 2) {
-                literals_count = strtol(tmp, NULL, 10);
-            } else if (i == 3) {
-                clauses_count = strtol(tmp, NULL, 10);
             }
 
             i++;
-            tmp = strtok(NULL, " ");
         }
 
         if (i != 4) {
@@ -95,201 +177,128 @@ Formula* DIMACSParser_parse_formula(char* str) {
 
         if (problem_line_error) {
             fprintf(stderr, "Error - missing/malformed problem line\n");
-            free(lines_v);
             return NULL;
         }
 
         if (literals_count == 0) {
             fprintf(stderr, "Error - number of literals is 0 according to problem line!\n");
             fprintf(stderr, " - this can't be right\n");
-            free(lines_v);
             return NULL;
         }
 
         if (clauses_count == 0) {
             fprintf(stderr, "Error - number of clauses is 0 according to problem line!\n");
             fprintf(stderr, " - this can't be right\n");
-            free(lines_v);
             return NULL;
         }
     }
-    linec++;
-
-    // Create list of ALL Literals in this Formula
-    LinkedList* all_literals = LinkedList_create((void(*)(void*))GenericLiteral_destroy);
-
-    // Create list of Clauses in this Formula
-    LinkedList* clauses = LinkedList_create((void(*)(void*))Clause_destroy);
-
-    // Parse Clauses
-    unsigned int clauses_found = 0;
-
-    for (; linec < lines_c; linec++) {
-        // Ignore it if the last line is empty
-        if (linec == lines_c - 1) {
-            if (strcmp(lines_v[linec],"") == 0) {
-                continue;
-            }
-        }
-
-        Clause* clause = DIMACSParser_parse_clause(lines_v[linec], all_literals);
-        if (clause == NULL) {
-            free(lines_v);
-            LinkedList_destroy(all_literals, true);
-            LinkedList_destroy(clauses, true);
-            return NULL;
-        }
-
-        LinkedList_append(clauses, clause);
-        clauses_found++;
-    }
-    free(lines_v);
-
-    // Check if given number of Clauses was correct
-    if (clauses_count != clauses_found) {
-        fprintf(stderr, "Error - number of clauses given in problem line is not correct!\n");
-        LinkedList_destroy(all_literals, true);
-        LinkedList_destroy(clauses, true);
-        return NULL;
-    }
-
-    // Check if given number of Literals was correct
-    if (literals_count != all_literals->size) {
-        fprintf(stderr, "Error - number of literals given in problem line is not correct!\n");
-        LinkedList_destroy(all_literals, true);
-        LinkedList_destroy(clauses, true);
-        return NULL;
-    }
-
-    // Convert list of all literals to array
-    int all_literals_c = all_literals->size;
-    GenericLiteral** all_literals_v = malloc(all_literals_c * sizeof(GenericLiteral*));
-    {
-        int i = 0;
-        for (LinkedListNode* iter = all_literals->head; iter != NULL; iter = iter->next) {
-            GenericLiteral* lit = iter->data;
-
-            all_literals_v[i] = lit;
-
-            i++;
-        }
-    }
-    LinkedList_destroy(all_literals, false);
-
-    // Create Formula from list of Clauses and array of all Literals
-    return Formula_create(clauses, all_literals_v, all_literals_c);
-}
-
-Clause* DIMACSParser_parse_clause(char* line, LinkedList* all_literals) {
-    // Empty lines are not permitted
-    if (strcmp(line, "") == 0) {
-        fprintf(stderr, "Error - empty lines are not permitted!\n");
-        return NULL;
-    }
 
-    // Split line by space
-    unsigned int line_c = 30;
-    char** line_v = malloc(line_c * sizeof(char*));
-    {
-        unsigned int line_filled = 0;
-
-        char* tmp = strtok(line, " ");
-        while (tmp != NULL) {
-            // Resize if necessary
-            if (line_filled + 1 > line_c) {
-                line_c *= 4;
-                line_v = realloc(line_v, line_c * sizeof(char*));
-            }
-
-            // Add to array
-            line_v[line_filled++] = tmp;
-
-            // Split off next line from string
-            tmp = strtok(NULL, " ");
+    // Create storage and list of Clauses in this Formula
+    ClauseArena* arena = ClauseArena_create(clauses_count * 8);
+    ClauseRefVector* clauses = ClauseRefVector_create(clauses_count);
+
+    // DIMACS Variables are numbered from 1 to the number given in the
+    // problem line, Variable n is stored at index n - 1.
+    // Remember which Variables occur to check the number of Variables.
+    unsigned int variables_c = literals_count;
+    unsigned int occurring_c = 0;
+    bool* occurs_v = calloc(variables_c, sizeof(bool));
+    assert(occurs_v != NULL);
+
+    // Literals of the Clause that is currently parsed
+    unsigned int literals_c = 0;
+    unsigned int literals_capacity = 64;
+    Literal* literals_v = malloc(literals_capacity * sizeof(Literal));
+    assert(literals_v != NULL);
+
+    // Parse Clauses, every Clause is terminated by 0
+    bool error = false;
+    while (true) {
+        DIMACSParser_skip(&input, false);
+
+        // Some benchmark files end with '%'
+        if (input.pos == input.end || *input.pos == '%') {
+            break;
         }
 
-        // Shrink array to minimum size required
-        line_c = line_filled;
-        line_v = realloc(line_v, line_c * sizeof(char*));
-    }
-
-    // Create list of Literals in Clause
-    LinkedList* clause_literals = LinkedList_create((void(*)(void*))Literal_destroy);
-
-    // Parse each Literal separately
-    for (unsigned int i = 0; i < line_c; i++) {
-        // Parse Literal int (name)
-        signed int a = strtol(line_v[i], NULL, 10);
-
-        // The last element of each line has to be 0
-        if (i == line_c - 1) {
-            if (a != 0) {
-                fprintf(stderr, "Error - Last element of line was not 0!\n");
-                return NULL;
-            }
+        long a;
+        if (!DIMACSParser_read_int(&input, &a)) {
+            const char* word;
+            size_t word_length = DIMACSParser_read_word(&input, &word);
+            fprintf(stderr, "Error - '%.*s' is not a valid literal!\n", (int)word_length, word);
+            error = true;
             break;
         }
 
-        // 0 is only allowed to be the last element of each line.
+        // End of Clause
         if (a == 0) {
-            fprintf(stderr, "Error - Found Literal 0, which is not permitted!\n");
-            return NULL;
+            ClauseRefVector_append(clauses, ClauseArena_add(arena, literals_v, literals_c, false));
+            literals_c = 0;
+            continue;
         }
 
-        // Parse Literal
         bool negated = false;
-        char* name = malloc(sizeof(int) * sizeof(char) + 1 * sizeof(char));
-
         if (a < 0) {
             negated = true;
-            a = abs(a);
+            a = -a;
         }
-        snprintf(name, 33, "%d", a);
-        name = realloc(name, (strlen(name) + 1) * sizeof(char));
-
-        // Create new GenericLiteral
-        GenericLiteral* new_literal = GenericLiteral_create(name, LiteralAssignment_UNSET);
-
-        // Check if Literal is already contained in list of all Literals
-        // If it is take that one, if not create a new one and add it to
-        // the list of all Literals.
-        bool literal_already_contained = false;
-        for (LinkedListNode* iter = all_literals->head; iter != NULL; iter = iter->next) {
-            GenericLiteral* found_literal = iter->data;
 
-            if (GenericLiteral_equals(found_literal, new_literal)) {
-                GenericLiteral_destroy(new_literal);
+        if (a > variables_c) {
+            fprintf(stderr, "Error - literal %ld exceeds number of literals given in problem line!\n", a);
+            error = true;
+            break;
+        }
 
-                new_literal = found_literal;
-                literal_already_contained = true;
-                break;
-            }
+        Variable variable = a - 1;
+        if (!occurs_v[variable]) {
+            occurs_v[variable] = true;
+            occurring_c++;
         }
 
-        if (!literal_already_contained) {
-            LinkedList_append(all_literals, new_literal);
+        // Add Literal to Clause
+        if (literals_c == literals_capacity) {
+            literals_capacity *= 2;
+            literals_v = realloc(literals_v, literals_capacity * sizeof(Literal));
+            assert(literals_v != NULL);
         }
+        literals_v[literals_c++] = Literal_create(variable, negated);
+    }
+    free(literals_v);
 
-        // Create new Literal
-        Literal* literal = Literal_create(new_literal, negated);
-        GenericLiteral_increase_occurrences(new_literal);
+    if (!error && literals_c != 0) {
+        fprintf(stderr, "Error - last clause is not terminated by 0!\n");
+        error = true;
+    }
 
-        // Add Literal to list of Literals
-        LinkedList_append(clause_literals, literal);
+    // Check if given number of Clauses was correct
+    if (!error && clauses_count != clauses->size) {
+        fprintf(stderr, "Error - number of clauses given in problem line is not correct!\n");
+        error = true;
     }
-    free(line_v);
 
-    // Create array of Literals from list of Literals
-    unsigned int literals_c = clause_literals->size;
-    Literal** literals_v = malloc(sizeof(Literal*) * literals_c);
-    {
-        int i = 0;
-        for (LinkedListNode* iter = clause_literals->head; iter != NULL; iter = iter->next) {
-            literals_v[i] = iter->data;
-            i++;
-        }
+    // Check if given number of Literals was correct
+    if (!error && literals_count != occurring_c) {
+        fprintf(stderr, "Error - number of literals given in problem line is not correct!\n");
+        error = true;
+    }
+
+    free(occurs_v);
+
+    if (error) {
+        ClauseRefVector_destroy(clauses);
+        ClauseArena_destroy(arena);
+        return NULL;
+    }
+
+    // Create names of all Variables
+    char** names_v = malloc(variables_c * sizeof(char*));
+    assert(names_v != NULL);
+    for (unsigned int i = 0; i < variables_c; i++) {
+        names_v[i] = malloc(12 * sizeof(char));
+        assert(names_v[i] != NULL);
+        snprintf(names_v[i], 12, "%u", i + 1);
     }
-    LinkedList_destroy(clause_literals, false);
 
-    return Clause_create(literals_v, literals_c);
+    // Create Formula from list of Clauses and array of all Variable names
+    return Formula_create(arena, clauses, names_v, variables_c);
 }
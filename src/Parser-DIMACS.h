@@ -14,17 +14,24 @@
 **/
 
 
+
+
 #ifndef PARSER_DIMACS_H
 #define PARSER_DIMACS_H
 
 
-#include "Literal.h"
-#include "Clause.h"
 #include "Formula.h"
 
+#include <stddef.h>
 
-Formula* DIMACSParser_parse_formula(char* str);
 
-Clause* DIMACSParser_parse_clause(char* line, LinkedList* all_literals);
+/**
+ * Parses a Formula in DIMACS format.
+ *
+ * The input does not have to be terminated by '\0' and is not modified,
+ * so it can be mapped directly from a file.
+ * Returns NULL if the input is malformed.
+**/
+Formula* DIMACSParser_parse_formula(const char* str, size_t length);
 
 #endif
@@ -0,0 +1,39 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+#include "Parser.h"
+#include "Parser-CNF.h"
+#include "Parser-DIMACS.h"
+#include "Constants.h"
+
+#include <string.h>
+
+
+Formula* Parser_parse_formula(const char* str, size_t length, ParserFormat format) {
+    // If format is not set we'll try to guess it.
+    if (format == ParserFormat_GUESS) {
+        if (memchr(str, CONSTANTS_CNFPARSE_CLAUSE_START, length) != NULL) {
+            format = ParserFormat_CNF;
+        } else {
+            format = ParserFormat_DIMACS;
+        }
+    }
+
+    if (format == ParserFormat_CNF) {
+        return CNFParser_parse_formula(str, length);
+    }
+    return DIMACSParser_parse_formula(str, length);
+}
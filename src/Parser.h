@@ -0,0 +1,48 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+#ifndef PARSER_H
+#define PARSER_H
+
+
+#include "Formula.h"
+
+#include <stddef.h>
+
+
+/**
+ * Represents the possible formats of an input.
+ *
+ * GUESS - CNF format if the input contains the character starting a
+ *         clause, DIMACS format otherwise
+ * CNF - Plain text formula
+ * DIMACS - DIMACS format
+**/
+typedef enum {
+    ParserFormat_GUESS,
+    ParserFormat_CNF,
+    ParserFormat_DIMACS
+} ParserFormat;
+
+
+/**
+ * Parses a Formula in the given format.
+ *
+ * Returns NULL if the input is malformed.
+**/
+Formula* Parser_parse_formula(const char* str, size_t length, ParserFormat format);
+
+#endif
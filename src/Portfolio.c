@@ -0,0 +1,167 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+
+
+#include "Portfolio.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+// Only learned Clauses with at most this many Literals are shared
+#define PORTFOLIO_SHARE_MAX_SIZE 8
+
+// Only learned Clauses with Literals of at most this many different
+// decision levels are shared
+#define PORTFOLIO_SHARE_MAX_LBD 4
+
+/**
+ * State shared by all threads of a portfolio.
+**/
+typedef struct {
+    Formula* formula;
+    FormulaEngine engine;
+
+    // Set by the first thread that decides the Formula
+    atomic_bool stop;
+    atomic_int winner;
+} Portfolio;
+
+/**
+ * A single solver of a portfolio.
+**/
+typedef struct {
+    Portfolio* portfolio;
+    unsigned int id;
+
+    pthread_t thread;
+    Formula* copy;
+    ClauseExchangePort* port;
+    FormulaStatus result;
+} PortfolioWorker;
+
+
+static void Portfolio_configure(Formula* copy, unsigned int id) {
+    // First solver runs as configured
+    if (id == 0) {
+        return;
+    }
+
+    static const DecisionPhase phases[] = {
+        DecisionPhase_SAVED,
+        DecisionPhase_NEGATIVE,
+        DecisionPhase_RANDOM,
+        DecisionPhase_POSITIVE
+    };
+
+    copy->decision_heuristic = DecisionHeuristic_VSIDS;
+    copy->decision_phase = phases[(id - 1) % 4];
+    Formula_set_seed(copy, id);
+}
+
+static void* Portfolio_run_worker(void* data) {
+    PortfolioWorker* worker = data;
+    Portfolio* portfolio = worker->portfolio;
+
+    worker->copy = Formula_copy(portfolio->formula);
+    worker->copy->stop = &portfolio->stop;
+    worker->copy->exchange = worker->port;
+    Portfolio_configure(worker->copy, worker->id);
+
+    worker->result = portfolio->engine(worker->copy);
+
+    // Stop all other threads if we are the first to decide the Formula
+    if (worker->result != FormulaStatus_UNDECIDED) {
+        int expected = -1;
+        if (atomic_compare_exchange_strong(&portfolio->winner, &expected, (int)worker->id)) {
+            atomic_store(&portfolio->stop, true);
+        }
+    }
+
+    return NULL;
+}
+
+FormulaStatus Portfolio_solve(Formula* formula, FormulaEngine engine, unsigned int threads_c) {
+    assert(formula != NULL);
+    assert(engine != NULL);
+    assert(threads_c > 0);
+
+    Portfolio portfolio;
+    portfolio.formula = formula;
+    portfolio.engine = engine;
+    atomic_init(&portfolio.stop, false);
+    atomic_init(&portfolio.winner, -1);
+
+    // Threads share short learned Clauses
+    ClauseExchange* exchange = ClauseExchange_create(threads_c,
+                                                     PORTFOLIO_SHARE_MAX_SIZE,
+                                                     PORTFOLIO_SHARE_MAX_LBD);
+
+    // Start all threads
+    PortfolioWorker* workers_v = malloc(threads_c * sizeof(PortfolioWorker));
+    assert(workers_v != NULL);
+    for (unsigned int i = 0; i < threads_c; i++) {
+        workers_v[i].portfolio = &portfolio;
+        workers_v[i].id = i;
+        workers_v[i].copy = NULL;
+        workers_v[i].port = ClauseExchangePort_create(exchange, i);
+        workers_v[i].result = FormulaStatus_UNDECIDED;
+
+        int error = pthread_create(&workers_v[i].thread, NULL, Portfolio_run_worker, &workers_v[i]);
+        assert(error == 0);
+        (void)error;
+    }
+
+    // Wait for all threads, they stop once the first one is done
+    for (unsigned int i = 0; i < threads_c; i++) {
+        pthread_join(workers_v[i].thread, NULL);
+    }
+
+    // Take result and assignment or failed assumptions of the thread that
+    // finished first
+    FormulaStatus result = FormulaStatus_UNDECIDED;
+    int winner = atomic_load(&portfolio.winner);
+    if (winner >= 0) {
+        PortfolioWorker* worker = &workers_v[winner];
+        result = worker->result;
+
+        if (result == FormulaStatus_TRUE) {
+            memcpy(formula->assignments_v,
+                   worker->copy->assignments_v,
+                   formula->variables_c * sizeof(LiteralAssignment));
+        } else {
+            // Without assumptions there is no array of failed ones
+            if (worker->copy->failed_c > 0) {
+                memcpy(formula->failed_v,
+                       worker->copy->failed_v,
+                       worker->copy->failed_c * sizeof(Literal));
+            }
+            formula->failed_c = worker->copy->failed_c;
+        }
+    }
+
+    for (unsigned int i = 0; i < threads_c; i++) {
+        Formula_destroy(workers_v[i].copy);
+        ClauseExchangePort_destroy(workers_v[i].port);
+    }
+    free(workers_v);
+    ClauseExchange_destroy(exchange);
+
+    return result;
+}
@@ -0,0 +1,42 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+
+
+#ifndef PORTFOLIO_H
+#define PORTFOLIO_H
+
+
+#include "Formula.h"
+
+
+/**
+ * Decides whether a Formula is satisfiable by running threads_c
+ * differently configured solvers on it in parallel.
+ *
+ * Every thread works on its own copy of the Formula, the given Formula is
+ * only read while the threads are running. The first thread to decide the
+ * Formula stops all others.
+ * The first thread uses the configuration of the given Formula, all others
+ * use VSIDS with different phases and seeds.
+ * Short learned Clauses are shared between the threads.
+ * If the Formula is satisfiable the satisfying assignment is stored in
+ * the given Formula, otherwise the failed assumptions are.
+**/
+FormulaStatus Portfolio_solve(Formula* formula, FormulaEngine engine, unsigned int threads_c);
+
+
+#endif
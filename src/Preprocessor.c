@@ -0,0 +1,1009 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+
+
+#include "Preprocessor.h"
+#include "ActivityHeap.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+// Variables are not eliminated if one of their resolvents would have more
+// Literals than this
+#define PREPROCESSOR_RESOLVENT_LIMIT 20
+
+// Variables are not eliminated if the number of their positive times the
+// number of their negative occurrences is larger than this, as trying
+// all pairs would take too long
+#define PREPROCESSOR_PAIRS_LIMIT 2500
+
+// Probing stops after visiting this many Literals of Clauses while
+// propagating tentatively assigned Literals
+#define PREPROCESSOR_PROBE_LIMIT 50000000
+
+/**
+ * Growable list of indices of Clauses.
+**/
+typedef struct {
+    uint32_t* data;
+    unsigned int size;
+    unsigned int capacity;
+} PreprocessorList;
+
+/**
+ * State of a running preprocessing.
+**/
+typedef struct {
+    Formula* formula;
+    ReconstructionStack* stack;
+
+    // Working copy of the Clauses, removed Clauses are marked as deleted.
+    // Clauses are referred to by their index in clauses, for every index
+    // there is a signature with the bit of every contained Variable
+    // (modulo 64) set and whether it is queued for subsumption.
+    ClauseArena* arena;
+    ClauseRefVector* clauses;
+    uint64_t* signatures_v;
+    bool* queued_v;
+    unsigned int clauses_capacity;
+
+    // For every Literal the Clauses containing it (including deleted
+    // ones) and the number of Clauses containing it that are not deleted
+    PreprocessorList* occurrences_v;
+    unsigned int* counts_v;
+
+    // Clauses that were added or strengthened and may subsume others
+    PreprocessorList pending;
+    unsigned int pending_head;
+
+    // Values of Variables fixed by One-Literal-Clauses, along with the
+    // fixed Literals in order of assignment. Literals after units_head
+    // have not been propagated yet.
+    LiteralAssignment* values_v;
+    Literal* units_v;
+    unsigned int units_c;
+    unsigned int units_head;
+    bool inconsistent;
+
+    // Variables to eliminate, the activity of a Variable is the negated
+    // product of its positive and negative occurrences. Only created once
+    // the original Clauses are simplified.
+    ActivityHeap* queue;
+
+    // Marks of Literals and buffer for building resolvents
+    bool* marks_v;
+    Literal* resolvent_v;
+} Preprocessor;
+
+
+static void PreprocessorList_append(PreprocessorList* list, uint32_t index) {
+    if (list->size == list->capacity) {
+        list->capacity = (list->capacity == 0) ? 4 : 2 * list->capacity;
+        list->data = realloc(list->data, list->capacity * sizeof(uint32_t));
+        assert(list->data != NULL);
+    }
+
+    list->data[list->size++] = index;
+}
+
+static void PreprocessorList_remove(PreprocessorList* list, uint32_t index) {
+    for (unsigned int i = 0; i < list->size; i++) {
+        if (list->data[i] == index) {
+            list->data[i] = list->data[--list->size];
+            return;
+        }
+    }
+}
+
+static inline Clause* Preprocessor_get_clause(Preprocessor* preprocessor, uint32_t index) {
+    return ClauseArena_get(preprocessor->arena, preprocessor->clauses->data[index]);
+}
+
+static uint64_t Preprocessor_signature(const Literal* literals_v, unsigned int literals_c) {
+    uint64_t signature = 0;
+    for (unsigned int i = 0; i < literals_c; i++) {
+        signature |= (uint64_t)1 << (Literal_get_variable(literals_v[i]) & 63);
+    }
+
+    return signature;
+}
+
+static inline bool Preprocessor_is_active(Preprocessor* preprocessor, Variable variable) {
+    return preprocessor->values_v[variable] == LiteralAssignment_UNSET &&
+           !preprocessor->formula->eliminated_v[variable];
+}
+
+/**
+ * Updates the position of a Variable whose occurrences changed in the
+ * queue of Variables to eliminate.
+**/
+static void Preprocessor_touch(Preprocessor* preprocessor, Variable variable) {
+    if (preprocessor->queue == NULL || !Preprocessor_is_active(preprocessor, variable)) {
+        return;
+    }
+
+    Literal positive = Literal_create(variable, false);
+    double cost = (double)preprocessor->counts_v[positive] * preprocessor->counts_v[Literal_negate(positive)];
+    ActivityHeap_set(preprocessor->queue, variable, -cost);
+    ActivityHeap_insert(preprocessor->queue, variable);
+}
+
+static void Preprocessor_enqueue(Preprocessor* preprocessor, uint32_t index) {
+    if (!preprocessor->queued_v[index]) {
+        preprocessor->queued_v[index] = true;
+        PreprocessorList_append(&preprocessor->pending, index);
+    }
+}
+
+static void Preprocessor_assign(Preprocessor* preprocessor, Literal literal) {
+    switch (Literal_evaluate(literal, preprocessor->values_v)) {
+        case LiteralAssignment_UNSET:
+            preprocessor->values_v[Literal_get_variable(literal)] =
+                Literal_is_negated(literal) ? LiteralAssignment_FALSE : LiteralAssignment_TRUE;
+            preprocessor->units_v[preprocessor->units_c++] = literal;
+            break;
+        case LiteralAssignment_FALSE:
+            preprocessor->inconsistent = true;
+            break;
+        case LiteralAssignment_TRUE:
+            break;
+    }
+}
+
+static void Preprocessor_add_clause(Preprocessor* preprocessor, const Literal* literals_v, unsigned int literals_c) {
+    uint32_t index = preprocessor->clauses->size;
+    if (index == preprocessor->clauses_capacity) {
+        preprocessor->clauses_capacity *= 2;
+        preprocessor->signatures_v = realloc(preprocessor->signatures_v,
+                                             preprocessor->clauses_capacity * sizeof(uint64_t));
+        preprocessor->queued_v = realloc(preprocessor->queued_v, preprocessor->clauses_capacity * sizeof(bool));
+        assert(preprocessor->signatures_v != NULL);
+        assert(preprocessor->queued_v != NULL);
+    }
+
+    ClauseRefVector_append(preprocessor->clauses, ClauseArena_add(preprocessor->arena, literals_v, literals_c, false));
+    preprocessor->signatures_v[index] = Preprocessor_signature(literals_v, literals_c);
+    preprocessor->queued_v[index] = false;
+    Preprocessor_enqueue(preprocessor, index);
+
+    for (unsigned int i = 0; i < literals_c; i++) {
+        PreprocessorList_append(&preprocessor->occurrences_v[literals_v[i]], index);
+        preprocessor->counts_v[literals_v[i]]++;
+        Preprocessor_touch(preprocessor, Literal_get_variable(literals_v[i]));
+    }
+
+    if (literals_c == 0) {
+        preprocessor->inconsistent = true;
+    } else if (literals_c == 1) {
+        Preprocessor_assign(preprocessor, literals_v[0]);
+    }
+}
+
+/**
+ * Deletes a Clause, which is written to the proof if log is set.
+**/
+static void Preprocessor_remove_clause(Preprocessor* preprocessor, uint32_t index, bool log) {
+    Clause* clause = Preprocessor_get_clause(preprocessor, index);
+    if (log && preprocessor->formula->proof != NULL) {
+        Proof_delete(preprocessor->formula->proof, clause->literals_v, clause->literals_c);
+    }
+
+    ClauseArena_delete(preprocessor->arena, preprocessor->clauses->data[index]);
+    for (unsigned int i = 0; i < clause->literals_c; i++) {
+        preprocessor->counts_v[clause->literals_v[i]]--;
+        Preprocessor_touch(preprocessor, Literal_get_variable(clause->literals_v[i]));
+    }
+}
+
+/**
+ * Removes a Literal from a Clause. The caller has to remove the Clause
+ * from the occurrences of the Literal.
+**/
+static void Preprocessor_strengthen(Preprocessor* preprocessor, uint32_t index, Literal literal) {
+    ClauseRef ref = preprocessor->clauses->data[index];
+    Clause* clause = ClauseArena_get(preprocessor->arena, ref);
+
+    unsigned int kept_c = 0;
+    for (unsigned int p = 0; p < clause->literals_c; p++) {
+        if (clause->literals_v[p] != literal) {
+            preprocessor->resolvent_v[kept_c++] = clause->literals_v[p];
+        }
+    }
+
+    Proof* proof = preprocessor->formula->proof;
+    if (proof != NULL) {
+        Proof_add(proof, preprocessor->resolvent_v, kept_c);
+        Proof_delete(proof, clause->literals_v, clause->literals_c);
+    }
+    memcpy(clause->literals_v, preprocessor->resolvent_v, kept_c * sizeof(Literal));
+    ClauseArena_shrink_clause(preprocessor->arena, ref, kept_c);
+    preprocessor->signatures_v[index] = Preprocessor_signature(clause->literals_v, kept_c);
+    preprocessor->counts_v[literal]--;
+
+    for (unsigned int p = 0; p < kept_c; p++) {
+        Preprocessor_touch(preprocessor, Literal_get_variable(clause->literals_v[p]));
+    }
+    if (kept_c == 0) {
+        preprocessor->inconsistent = true;
+    } else if (kept_c == 1) {
+        Preprocessor_assign(preprocessor, clause->literals_v[0]);
+    }
+
+    // The shorter Clause may subsume other Clauses now
+    Preprocessor_enqueue(preprocessor, index);
+}
+
+/**
+ * Removes the Clauses satisfied by fixed Literals and the false Literals
+ * from all other Clauses.
+**/
+static void Preprocessor_propagate(Preprocessor* preprocessor) {
+    while (preprocessor->units_head < preprocessor->units_c && !preprocessor->inconsistent) {
+        Literal literal = preprocessor->units_v[preprocessor->units_head++];
+
+        // Satisfied Clauses are not deleted from the proof, so that it
+        // keeps the One-Literal-Clause of the Literal
+        PreprocessorList* satisfied = &preprocessor->occurrences_v[literal];
+        for (unsigned int i = 0; i < satisfied->size; i++) {
+            if (!Preprocessor_get_clause(preprocessor, satisfied->data[i])->deleted) {
+                Preprocessor_remove_clause(preprocessor, satisfied->data[i], false);
+            }
+        }
+        satisfied->size = 0;
+
+        PreprocessorList* falsified = &preprocessor->occurrences_v[Literal_negate(literal)];
+        for (unsigned int i = 0; i < falsified->size; i++) {
+            if (!Preprocessor_get_clause(preprocessor, falsified->data[i])->deleted) {
+                Preprocessor_strengthen(preprocessor, falsified->data[i], Literal_negate(literal));
+            }
+        }
+        falsified->size = 0;
+    }
+}
+
+/**
+ * Removes all Clauses subsumed by the given Clause, which are the ones
+ * containing all of its Literals, and strengthens the Clauses that contain
+ * all of its Literals but one, which they contain negated, by removing
+ * that negated Literal (self-subsuming resolution).
+ *
+ * Such Clauses contain the Variable of every Literal of the Clause, so
+ * only the occurrences of its Variable with the fewest of them have to be
+ * checked. Clauses whose signature lacks a bit of the signature of the
+ * Clause are skipped without looking at their Literals.
+**/
+static void Preprocessor_subsume(Preprocessor* preprocessor, uint32_t index) {
+    Clause* clause = Preprocessor_get_clause(preprocessor, index);
+    unsigned int literals_c = clause->literals_c;
+    uint64_t signature = preprocessor->signatures_v[index];
+
+    Literal best = clause->literals_v[0];
+    for (unsigned int p = 1; p < literals_c; p++) {
+        Literal literal = clause->literals_v[p];
+        if (preprocessor->counts_v[literal] + preprocessor->counts_v[Literal_negate(literal)] <
+            preprocessor->counts_v[best] + preprocessor->counts_v[Literal_negate(best)]) {
+            best = literal;
+        }
+    }
+
+    for (unsigned int p = 0; p < literals_c; p++) {
+        preprocessor->marks_v[clause->literals_v[p]] = true;
+    }
+
+    for (unsigned int sign = 0; sign < 2; sign++) {
+        PreprocessorList* occurrences = &preprocessor->occurrences_v[sign ? Literal_negate(best) : best];
+
+        for (unsigned int i = 0; i < occurrences->size; i++) {
+            uint32_t other_index = occurrences->data[i];
+            if ((signature & ~preprocessor->signatures_v[other_index]) != 0 || other_index == index) {
+                continue;
+            }
+
+            Clause* other = Preprocessor_get_clause(preprocessor, other_index);
+            if (other->deleted || other->literals_c < literals_c) {
+                continue;
+            }
+
+            unsigned int matches_c = 0;
+            unsigned int negations_c = 0;
+            Literal negation = 0;
+            for (unsigned int p = 0; p < other->literals_c; p++) {
+                Literal literal = other->literals_v[p];
+                if (preprocessor->marks_v[literal]) {
+                    matches_c++;
+                } else if (preprocessor->marks_v[Literal_negate(literal)]) {
+                    negations_c++;
+                    negation = literal;
+                }
+            }
+
+            if (matches_c == literals_c) {
+                Preprocessor_remove_clause(preprocessor, other_index, true);
+            } else if (matches_c + 1 == literals_c && negations_c == 1) {
+                // The strengthened Clause leaves the occurrences that are
+                // just being visited if it is one of them
+                PreprocessorList_remove(&preprocessor->occurrences_v[negation], other_index);
+                if (Literal_get_variable(negation) == Literal_get_variable(best)) {
+                    i--;
+                }
+                Preprocessor_strengthen(preprocessor, other_index, negation);
+            }
+        }
+    }
+
+    // Strengthening only changes other Clauses, so the Literals of this
+    // one are still the marked ones
+    clause = Preprocessor_get_clause(preprocessor, index);
+    for (unsigned int p = 0; p < clause->literals_c; p++) {
+        preprocessor->marks_v[clause->literals_v[p]] = false;
+    }
+}
+
+/**
+ * Lets every pending Clause subsume and strengthen other Clauses and
+ * propagates the fixed Literals found along the way.
+**/
+static void Preprocessor_subsume_pending(Preprocessor* preprocessor) {
+    while (preprocessor->pending_head < preprocessor->pending.size && !preprocessor->inconsistent) {
+        uint32_t index = preprocessor->pending.data[preprocessor->pending_head++];
+        preprocessor->queued_v[index] = false;
+
+        Clause* clause = Preprocessor_get_clause(preprocessor, index);
+        if (!clause->deleted && clause->literals_c > 0) {
+            Preprocessor_subsume(preprocessor, index);
+        }
+        Preprocessor_propagate(preprocessor);
+    }
+
+    preprocessor->pending.size = 0;
+    preprocessor->pending_head = 0;
+}
+
+/**
+ * Returns the other Literal of a Clause with two Literals, or the
+ * Literal itself if the Clause is deleted or has another length.
+**/
+static inline Literal Preprocessor_binary_partner(Preprocessor* preprocessor, uint32_t index, Literal literal) {
+    Clause* clause = Preprocessor_get_clause(preprocessor, index);
+    if (clause->deleted || clause->literals_c != 2) {
+        return literal;
+    }
+
+    return (clause->literals_v[0] == literal) ? clause->literals_v[1] : clause->literals_v[0];
+}
+
+/**
+ * Finds Literals that imply each other through Clauses with two Literals,
+ * which are the strongly connected components of the graph with an edge
+ * from the negation of each of their Literals to the other one, and
+ * replaces each of them by the Literal with the smallest Variable of its
+ * component (Tarjan's algorithm, without recursion).
+ *
+ * A component containing both a Literal and its negation makes the
+ * Formula inconsistent.
+**/
+static void Preprocessor_substitute(Preprocessor* preprocessor) {
+    unsigned int literals_c = 2 * preprocessor->formula->variables_c;
+
+    // Indices in the order of visiting start at 1, 0 marks unvisited
+    // Literals
+    unsigned int* indices_v = calloc(literals_c, sizeof(unsigned int));
+    unsigned int* lows_v = malloc(literals_c * sizeof(unsigned int));
+    bool* on_stack_v = calloc(literals_c, sizeof(bool));
+    Literal* stack_v = malloc(literals_c * sizeof(Literal));
+    Literal* path_v = malloc(literals_c * sizeof(Literal));
+    unsigned int* positions_v = malloc(literals_c * sizeof(unsigned int));
+    Literal* representatives_v = malloc(literals_c * sizeof(Literal));
+    assert(indices_v != NULL || literals_c == 0);
+    assert(lows_v != NULL || literals_c == 0);
+    assert(on_stack_v != NULL || literals_c == 0);
+    assert(stack_v != NULL || literals_c == 0);
+    assert(path_v != NULL || literals_c == 0);
+    assert(positions_v != NULL || literals_c == 0);
+    assert(representatives_v != NULL || literals_c == 0);
+    for (Literal literal = 0; literal < literals_c; literal++) {
+        representatives_v[literal] = literal;
+    }
+
+    unsigned int visited_c = 0;
+    unsigned int stack_c = 0;
+    bool substituted = false;
+    bool contradiction = false;
+    for (Literal root = 0; root < literals_c && !contradiction; root++) {
+        if (indices_v[root] != 0 || !Preprocessor_is_active(preprocessor, Literal_get_variable(root))) {
+            continue;
+        }
+
+        unsigned int path_c = 0;
+        path_v[path_c] = root;
+        positions_v[path_c++] = 0;
+        indices_v[root] = lows_v[root] = ++visited_c;
+        on_stack_v[root] = true;
+        stack_v[stack_c++] = root;
+
+        while (path_c > 0 && !contradiction) {
+            Literal literal = path_v[path_c - 1];
+            PreprocessorList* implications = &preprocessor->occurrences_v[Literal_negate(literal)];
+
+            // Follow the next edge to an unvisited Literal
+            bool descended = false;
+            while (positions_v[path_c - 1] < implications->size && !descended) {
+                uint32_t index = implications->data[positions_v[path_c - 1]++];
+                Literal implied = Preprocessor_binary_partner(preprocessor, index, Literal_negate(literal));
+                if (implied == Literal_negate(literal)) {
+                    continue;
+                }
+
+                if (indices_v[implied] == 0) {
+                    path_v[path_c] = implied;
+                    positions_v[path_c++] = 0;
+                    indices_v[implied] = lows_v[implied] = ++visited_c;
+                    on_stack_v[implied] = true;
+                    stack_v[stack_c++] = implied;
+                    descended = true;
+                } else if (on_stack_v[implied] && indices_v[implied] < lows_v[literal]) {
+                    lows_v[literal] = indices_v[implied];
+                }
+            }
+            if (descended) {
+                continue;
+            }
+
+            path_c--;
+            if (path_c > 0 && lows_v[literal] < lows_v[path_v[path_c - 1]]) {
+                lows_v[path_v[path_c - 1]] = lows_v[literal];
+            }
+            if (lows_v[literal] != indices_v[literal]) {
+                continue;
+            }
+
+            // The Literal is the first visited one of its component, which
+            // are all Literals above it on the stack
+            unsigned int start = stack_c;
+            do {
+                start--;
+                on_stack_v[stack_v[start]] = false;
+            } while (stack_v[start] != literal);
+
+            Literal representative = stack_v[start];
+            for (unsigned int i = start; i < stack_c; i++) {
+                preprocessor->marks_v[stack_v[i]] = true;
+                if (Literal_get_variable(stack_v[i]) < Literal_get_variable(representative)) {
+                    representative = stack_v[i];
+                }
+            }
+            for (unsigned int i = start; i < stack_c; i++) {
+                contradiction |= preprocessor->marks_v[Literal_negate(stack_v[i])];
+            }
+            for (unsigned int i = start; i < stack_c; i++) {
+                preprocessor->marks_v[stack_v[i]] = false;
+            }
+
+            if (contradiction) {
+                // The negation of the Literal follows from it, so it is
+                // false, which makes the negation of the negation false
+                // as well once propagated
+                Literal negation = Literal_negate(literal);
+                if (preprocessor->formula->proof != NULL) {
+                    Proof_add(preprocessor->formula->proof, &negation, 1);
+                }
+                Preprocessor_assign(preprocessor, negation);
+            } else if (!Literal_is_negated(representative)) {
+                // The component of the negations is substituted along
+                // with this one
+                for (unsigned int i = start; i < stack_c; i++) {
+                    Literal equivalent = stack_v[i];
+                    if (equivalent == representative) {
+                        continue;
+                    }
+
+                    representatives_v[equivalent] = representative;
+                    representatives_v[Literal_negate(equivalent)] = Literal_negate(representative);
+
+                    // Both implications are written to the proof before
+                    // any Clause is changed, as the chains of Clauses
+                    // they follow from get lost by substituting
+                    Literal implications_v[2][2] = {
+                        {equivalent, Literal_negate(representative)},
+                        {Literal_negate(equivalent), representative}
+                    };
+                    for (unsigned int j = 0; j < 2; j++) {
+                        if (preprocessor->formula->proof != NULL) {
+                            Proof_add(preprocessor->formula->proof, implications_v[j], 2);
+                        }
+                        ReconstructionStack_push(preprocessor->stack, implications_v[j][0], implications_v[j], 2);
+                    }
+                    preprocessor->formula->eliminated_v[Literal_get_variable(equivalent)] = true;
+                    substituted = true;
+                }
+            }
+            stack_c = start;
+        }
+    }
+
+    // Rewrite every Clause containing a substituted Variable, dropping
+    // duplicate Literals and Clauses that became tautologies
+    unsigned int clauses_c = preprocessor->clauses->size;
+    for (uint32_t index = 0; index < clauses_c && substituted && !contradiction; index++) {
+        Clause* clause = Preprocessor_get_clause(preprocessor, index);
+        if (clause->deleted) {
+            continue;
+        }
+
+        bool changed = false;
+        for (unsigned int p = 0; p < clause->literals_c; p++) {
+            changed |= representatives_v[clause->literals_v[p]] != clause->literals_v[p];
+        }
+        if (!changed) {
+            continue;
+        }
+
+        unsigned int length = 0;
+        bool tautology = false;
+        for (unsigned int p = 0; p < clause->literals_c; p++) {
+            Literal literal = representatives_v[clause->literals_v[p]];
+            tautology |= preprocessor->marks_v[Literal_negate(literal)];
+            if (!preprocessor->marks_v[literal]) {
+                preprocessor->marks_v[literal] = true;
+                preprocessor->resolvent_v[length++] = literal;
+            }
+        }
+        for (unsigned int p = 0; p < length; p++) {
+            preprocessor->marks_v[preprocessor->resolvent_v[p]] = false;
+        }
+
+        if (!tautology && preprocessor->formula->proof != NULL) {
+            Proof_add(preprocessor->formula->proof, preprocessor->resolvent_v, length);
+        }
+        Preprocessor_remove_clause(preprocessor, index, true);
+        if (!tautology) {
+            Preprocessor_add_clause(preprocessor, preprocessor->resolvent_v, length);
+        }
+    }
+
+    // Substituted Variables only remain in deleted Clauses
+    for (Literal literal = 0; literal < literals_c && substituted && !contradiction; literal++) {
+        if (representatives_v[literal] != literal) {
+            preprocessor->occurrences_v[literal].size = 0;
+        }
+    }
+
+    free(indices_v);
+    free(lows_v);
+    free(on_stack_v);
+    free(stack_v);
+    free(path_v);
+    free(positions_v);
+    free(representatives_v);
+
+    Preprocessor_propagate(preprocessor);
+}
+
+/**
+ * Assigns a Literal tentatively and propagates it through all Clauses,
+ * appending the implied Literals (starting with the Literal itself) to
+ * the trail. Every visited Literal of a Clause counts as a tick.
+ *
+ * Returns false if a Clause becomes false.
+**/
+static bool Preprocessor_probe_literal(Preprocessor* preprocessor, Literal literal, Literal* trail_v,
+                                       unsigned int* trail_c, unsigned long* ticks) {
+    LiteralAssignment* values_v = preprocessor->values_v;
+    unsigned int head = *trail_c;
+    values_v[Literal_get_variable(literal)] = Literal_is_negated(literal) ? LiteralAssignment_FALSE
+                                                                          : LiteralAssignment_TRUE;
+    trail_v[(*trail_c)++] = literal;
+
+    while (head < *trail_c) {
+        PreprocessorList* falsified = &preprocessor->occurrences_v[Literal_negate(trail_v[head++])];
+
+        for (unsigned int i = 0; i < falsified->size; i++) {
+            Clause* clause = Preprocessor_get_clause(preprocessor, falsified->data[i]);
+            if (clause->deleted) {
+                continue;
+            }
+
+            unsigned int unset_c = 0;
+            Literal unit = 0;
+            bool satisfied = false;
+            for (unsigned int p = 0; p < clause->literals_c && !satisfied; p++) {
+                switch (Literal_evaluate(clause->literals_v[p], values_v)) {
+                    case LiteralAssignment_TRUE:
+                        satisfied = true;
+                        break;
+                    case LiteralAssignment_UNSET:
+                        unset_c++;
+                        unit = clause->literals_v[p];
+                        break;
+                    case LiteralAssignment_FALSE:
+                        break;
+                }
+            }
+            *ticks += clause->literals_c;
+
+            if (satisfied || unset_c > 1) {
+                continue;
+            }
+            if (unset_c == 0) {
+                return false;
+            }
+
+            values_v[Literal_get_variable(unit)] = Literal_is_negated(unit) ? LiteralAssignment_FALSE
+                                                                            : LiteralAssignment_TRUE;
+            trail_v[(*trail_c)++] = unit;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Returns whether a Literal occurs in a Clause with two Literals, so that
+ * assigning its negation implies something.
+**/
+static bool Preprocessor_is_probed(Preprocessor* preprocessor, Literal literal) {
+    PreprocessorList* occurrences = &preprocessor->occurrences_v[literal];
+    for (unsigned int i = 0; i < occurrences->size; i++) {
+        if (Preprocessor_binary_partner(preprocessor, occurrences->data[i], literal) != literal) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Fixes a Literal implied by both Literals of a Variable, which is written
+ * to the proof along with the two implications it follows from.
+**/
+static void Preprocessor_lift(Preprocessor* preprocessor, Literal probe, Literal implied) {
+    Proof* proof = preprocessor->formula->proof;
+    if (proof != NULL) {
+        Literal implications_v[2][2] = {
+            {Literal_negate(probe), implied},
+            {probe, implied}
+        };
+        Proof_add(proof, implications_v[0], 2);
+        Proof_add(proof, implications_v[1], 2);
+        Proof_add(proof, &implied, 1);
+        Proof_delete(proof, implications_v[0], 2);
+        Proof_delete(proof, implications_v[1], 2);
+    }
+
+    Preprocessor_assign(preprocessor, implied);
+}
+
+/**
+ * Assigns both Literals of every Variable tentatively (failed literal
+ * probing). A Literal whose propagation makes a Clause false is fixed to
+ * false, and Literals implied by both Literals of a Variable are fixed to
+ * true. Only Literals that imply something through Clauses with two
+ * Literals are tried and probing stops after PREPROCESSOR_PROBE_LIMIT
+ * ticks.
+**/
+static void Preprocessor_probe(Preprocessor* preprocessor) {
+    unsigned int variables_c = preprocessor->formula->variables_c;
+    Literal* trail_v = malloc((2 * variables_c + 1) * sizeof(Literal));
+    assert(trail_v != NULL);
+
+    unsigned long ticks = 0;
+    for (Variable variable = 0; variable < variables_c && ticks < PREPROCESSOR_PROBE_LIMIT; variable++) {
+        if (preprocessor->inconsistent) {
+            break;
+        }
+        if (!Preprocessor_is_active(preprocessor, variable)) {
+            continue;
+        }
+
+        Literal positive = Literal_create(variable, false);
+        Literal negative = Literal_negate(positive);
+        if (!Preprocessor_is_probed(preprocessor, negative) && !Preprocessor_is_probed(preprocessor, positive)) {
+            continue;
+        }
+
+        // The Literals implied by the positive Literal stay marked while
+        // the negative one is probed
+        unsigned int positives_c = 0;
+        bool positive_failed = !Preprocessor_probe_literal(preprocessor, positive, trail_v, &positives_c, &ticks);
+        for (unsigned int i = 0; i < positives_c; i++) {
+            preprocessor->values_v[Literal_get_variable(trail_v[i])] = LiteralAssignment_UNSET;
+            preprocessor->marks_v[trail_v[i]] = !positive_failed;
+        }
+
+        unsigned int trail_c = positives_c;
+        bool negative_failed = positive_failed ||
+                               !Preprocessor_probe_literal(preprocessor, negative, trail_v, &trail_c, &ticks);
+        for (unsigned int i = positives_c; i < trail_c; i++) {
+            preprocessor->values_v[Literal_get_variable(trail_v[i])] = LiteralAssignment_UNSET;
+        }
+
+        Proof* proof = preprocessor->formula->proof;
+        if (positive_failed || negative_failed) {
+            Literal failed = positive_failed ? positive : negative;
+            Literal negation = Literal_negate(failed);
+            if (proof != NULL) {
+                Proof_add(proof, &negation, 1);
+            }
+            Preprocessor_assign(preprocessor, negation);
+        } else {
+            for (unsigned int i = positives_c + 1; i < trail_c; i++) {
+                if (preprocessor->marks_v[trail_v[i]]) {
+                    Preprocessor_lift(preprocessor, positive, trail_v[i]);
+                }
+            }
+        }
+
+        for (unsigned int i = 0; i < positives_c; i++) {
+            preprocessor->marks_v[trail_v[i]] = false;
+        }
+        Preprocessor_propagate(preprocessor);
+    }
+
+    free(trail_v);
+}
+
+/**
+ * Writes the resolvent of two Clauses on the given Variable to the
+ * resolvent buffer.
+ *
+ * Returns false if the resolvent is tautological.
+**/
+static bool Preprocessor_resolve(Preprocessor* preprocessor, uint32_t first_index, uint32_t second_index,
+                                 Variable variable, unsigned int* resolvent_c) {
+    Clause* first = Preprocessor_get_clause(preprocessor, first_index);
+    Clause* second = Preprocessor_get_clause(preprocessor, second_index);
+    unsigned int length = 0;
+
+    for (unsigned int p = 0; p < first->literals_c; p++) {
+        Literal literal = first->literals_v[p];
+        if (Literal_get_variable(literal) != variable) {
+            preprocessor->marks_v[literal] = true;
+            preprocessor->resolvent_v[length++] = literal;
+        }
+    }
+
+    bool tautology = false;
+    for (unsigned int p = 0; p < second->literals_c && !tautology; p++) {
+        Literal literal = second->literals_v[p];
+        if (Literal_get_variable(literal) == variable || preprocessor->marks_v[literal]) {
+            continue;
+        }
+
+        if (preprocessor->marks_v[Literal_negate(literal)]) {
+            tautology = true;
+        } else {
+            preprocessor->resolvent_v[length++] = literal;
+        }
+    }
+
+    for (unsigned int p = 0; p < first->literals_c; p++) {
+        preprocessor->marks_v[first->literals_v[p]] = false;
+    }
+
+    *resolvent_c = length;
+    return !tautology;
+}
+
+/**
+ * Removes deleted Clauses from a list of occurrences.
+**/
+static void Preprocessor_compact(Preprocessor* preprocessor, PreprocessorList* occurrences) {
+    unsigned int kept_c = 0;
+    for (unsigned int i = 0; i < occurrences->size; i++) {
+        if (!Preprocessor_get_clause(preprocessor, occurrences->data[i])->deleted) {
+            occurrences->data[kept_c++] = occurrences->data[i];
+        }
+    }
+    occurrences->size = kept_c;
+}
+
+/**
+ * Replaces all Clauses containing the Variable by their resolvents if
+ * there are no more of them.
+**/
+static void Preprocessor_eliminate(Preprocessor* preprocessor, Variable variable) {
+    Literal positive = Literal_create(variable, false);
+    PreprocessorList* positives = &preprocessor->occurrences_v[positive];
+    PreprocessorList* negatives = &preprocessor->occurrences_v[Literal_negate(positive)];
+    Preprocessor_compact(preprocessor, positives);
+    Preprocessor_compact(preprocessor, negatives);
+
+    if ((uint64_t)positives->size * negatives->size > PREPROCESSOR_PAIRS_LIMIT) {
+        return;
+    }
+
+    // Count the resolvents before adding any of them
+    unsigned int resolvents_c = 0;
+    for (unsigned int i = 0; i < positives->size; i++) {
+        for (unsigned int j = 0; j < negatives->size; j++) {
+            unsigned int length;
+            if (!Preprocessor_resolve(preprocessor, positives->data[i], negatives->data[j], variable, &length)) {
+                continue;
+            }
+
+            resolvents_c++;
+            if (length > PREPROCESSOR_RESOLVENT_LIMIT || resolvents_c > positives->size + negatives->size) {
+                return;
+            }
+        }
+    }
+
+    // Resolvents don't contain the Variable, so adding them leaves its
+    // occurrences alone
+    for (unsigned int i = 0; i < positives->size; i++) {
+        for (unsigned int j = 0; j < negatives->size; j++) {
+            unsigned int length;
+            if (Preprocessor_resolve(preprocessor, positives->data[i], negatives->data[j], variable, &length)) {
+                if (preprocessor->formula->proof != NULL) {
+                    Proof_add(preprocessor->formula->proof, preprocessor->resolvent_v, length);
+                }
+                Preprocessor_add_clause(preprocessor, preprocessor->resolvent_v, length);
+            }
+        }
+    }
+
+    // Only the Clauses of the side with fewer of them are needed to
+    // extend models: The Variable gets the value that satisfies the other
+    // side, unless one of these Clauses would be false then
+    bool keep_positives = positives->size <= negatives->size;
+    PreprocessorList* kept = keep_positives ? positives : negatives;
+    Literal pivot = keep_positives ? positive : Literal_negate(positive);
+    for (unsigned int i = 0; i < kept->size; i++) {
+        Clause* clause = Preprocessor_get_clause(preprocessor, kept->data[i]);
+        ReconstructionStack_push(preprocessor->stack, pivot, clause->literals_v, clause->literals_c);
+    }
+    Literal other = Literal_negate(pivot);
+    ReconstructionStack_push(preprocessor->stack, other, &other, 1);
+
+    preprocessor->formula->eliminated_v[variable] = true;
+    for (unsigned int i = 0; i < positives->size; i++) {
+        Preprocessor_remove_clause(preprocessor, positives->data[i], true);
+    }
+    for (unsigned int i = 0; i < negatives->size; i++) {
+        Preprocessor_remove_clause(preprocessor, negatives->data[i], true);
+    }
+    positives->size = 0;
+    negatives->size = 0;
+
+    Preprocessor_propagate(preprocessor);
+}
+
+void Preprocessor_run(Formula* formula, ReconstructionStack* stack) {
+    assert(formula != NULL);
+    assert(stack != NULL);
+    assert(formula->learned_clauses->size == 0);
+
+    unsigned int variables_c = formula->variables_c;
+    unsigned int literals_c = 2 * variables_c;
+
+    Preprocessor preprocessor;
+    preprocessor.formula = formula;
+    preprocessor.stack = stack;
+    preprocessor.arena = ClauseArena_create(formula->arena->size);
+    preprocessor.clauses_capacity = formula->clauses->size + 1;
+    preprocessor.clauses = ClauseRefVector_create(preprocessor.clauses_capacity);
+    preprocessor.signatures_v = malloc(preprocessor.clauses_capacity * sizeof(uint64_t));
+    preprocessor.queued_v = malloc(preprocessor.clauses_capacity * sizeof(bool));
+    preprocessor.occurrences_v = calloc(literals_c, sizeof(PreprocessorList));
+    preprocessor.counts_v = calloc(literals_c, sizeof(unsigned int));
+    preprocessor.values_v = malloc(variables_c * sizeof(LiteralAssignment));
+    preprocessor.units_v = malloc(variables_c * sizeof(Literal));
+    preprocessor.marks_v = calloc(literals_c, sizeof(bool));
+    preprocessor.resolvent_v = malloc((variables_c + 1) * sizeof(Literal));
+    assert(preprocessor.signatures_v != NULL);
+    assert(preprocessor.queued_v != NULL);
+    assert(preprocessor.occurrences_v != NULL || literals_c == 0);
+    assert(preprocessor.counts_v != NULL || literals_c == 0);
+    assert(preprocessor.values_v != NULL || variables_c == 0);
+    assert(preprocessor.units_v != NULL || variables_c == 0);
+    assert(preprocessor.marks_v != NULL || literals_c == 0);
+    assert(preprocessor.resolvent_v != NULL);
+    for (Variable variable = 0; variable < variables_c; variable++) {
+        preprocessor.values_v[variable] = LiteralAssignment_UNSET;
+    }
+    preprocessor.pending.data = NULL;
+    preprocessor.pending.size = 0;
+    preprocessor.pending.capacity = 0;
+    preprocessor.pending_head = 0;
+    preprocessor.units_c = 0;
+    preprocessor.units_head = 0;
+    preprocessor.inconsistent = false;
+    preprocessor.queue = NULL;
+
+    // Copy the original Clauses except for tautologies, duplicate
+    // Literals were already removed when the Formula watched them
+    for (unsigned int i = 0; i < formula->clauses->size && !preprocessor.inconsistent; i++) {
+        Clause* clause = ClauseArena_get(formula->arena, formula->clauses->data[i]);
+
+        bool tautology = false;
+        for (unsigned int p = 0; p < clause->literals_c; p++) {
+            tautology |= preprocessor.marks_v[Literal_negate(clause->literals_v[p])];
+            preprocessor.marks_v[clause->literals_v[p]] = true;
+        }
+        for (unsigned int p = 0; p < clause->literals_c; p++) {
+            preprocessor.marks_v[clause->literals_v[p]] = false;
+        }
+
+        if (!tautology) {
+            Preprocessor_add_clause(&preprocessor, clause->literals_v, clause->literals_c);
+        }
+    }
+    Preprocessor_propagate(&preprocessor);
+    Preprocessor_subsume_pending(&preprocessor);
+    if (!preprocessor.inconsistent) {
+        Preprocessor_substitute(&preprocessor);
+        Preprocessor_subsume_pending(&preprocessor);
+    }
+    if (!preprocessor.inconsistent) {
+        Preprocessor_probe(&preprocessor);
+        Preprocessor_subsume_pending(&preprocessor);
+    }
+
+    preprocessor.queue = ActivityHeap_create(variables_c);
+    for (Variable variable = 0; variable < variables_c; variable++) {
+        Preprocessor_touch(&preprocessor, variable);
+    }
+
+    // Try Variables with the fewest pairs of occurrences first. Whenever
+    // the occurrences of a Variable change it is tried again. Resolvents
+    // are used for subsumption right away.
+    while (!preprocessor.inconsistent && !ActivityHeap_is_empty(preprocessor.queue)) {
+        Variable variable = ActivityHeap_pop(preprocessor.queue);
+        if (Preprocessor_is_active(&preprocessor, variable)) {
+            Preprocessor_eliminate(&preprocessor, variable);
+            Preprocessor_subsume_pending(&preprocessor);
+        }
+    }
+
+    // The simplified Formula consists of the fixed Literals and the
+    // remaining Clauses, or just the empty Clause
+    ClauseArena* arena = ClauseArena_create(preprocessor.arena->size - preprocessor.arena->wasted);
+    ClauseRefVector* clauses = ClauseRefVector_create(preprocessor.clauses->size + 1);
+    if (preprocessor.inconsistent) {
+        ClauseRefVector_append(clauses, ClauseArena_add(arena, NULL, 0, false));
+    } else {
+        for (unsigned int i = 0; i < preprocessor.units_c; i++) {
+            ClauseRefVector_append(clauses, ClauseArena_add(arena, &preprocessor.units_v[i], 1, false));
+        }
+        for (unsigned int i = 0; i < preprocessor.clauses->size; i++) {
+            Clause* clause = Preprocessor_get_clause(&preprocessor, i);
+            if (!clause->deleted) {
+                ClauseRefVector_append(clauses, ClauseArena_add(arena, clause->literals_v, clause->literals_c, false));
+            }
+        }
+    }
+    Formula_replace_clauses(formula, arena, clauses);
+
+    for (unsigned int i = 0; i < literals_c; i++) {
+        free(preprocessor.occurrences_v[i].data);
+    }
+    free(preprocessor.occurrences_v);
+    free(preprocessor.counts_v);
+    free(preprocessor.pending.data);
+    free(preprocessor.signatures_v);
+    free(preprocessor.queued_v);
+    free(preprocessor.values_v);
+    free(preprocessor.units_v);
+    free(preprocessor.marks_v);
+    free(preprocessor.resolvent_v);
+    ActivityHeap_destroy(preprocessor.queue);
+    ClauseRefVector_destroy(preprocessor.clauses);
+    ClauseArena_destroy(preprocessor.arena);
+}
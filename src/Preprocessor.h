@@ -0,0 +1,55 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+
+
+#ifndef PREPROCESSOR_H
+#define PREPROCESSOR_H
+
+
+#include "Formula.h"
+#include "ReconstructionStack.h"
+
+
+/**
+ * Simplifies the Clauses of a Formula before it is searched.
+ *
+ * One-Literal-Clauses are propagated, Clauses that contain all Literals
+ * of another Clause are removed (subsumption) and Literals whose negation
+ * could be resolved away with another Clause that contains the rest of
+ * them are removed (self-subsuming resolution).
+ * Literals that imply each other through Clauses with two Literals are
+ * replaced by one of them and both Literals of every Variable are
+ * propagated tentatively, fixing those that make a Clause false and the
+ * ones implied by both (failed literal probing).
+ * Then Variables are eliminated by replacing all Clauses containing them
+ * by their non-tautological resolvents (bounded variable elimination),
+ * as long as this does not increase the number of Clauses. Variables with
+ * the fewest resolvents are eliminated first and new resolvents are used
+ * for subsumption as well. The removed Clauses are pushed to the given
+ * ReconstructionStack to extend models of the simplified Formula, the
+ * eliminated and substituted Variables are marked in the Formula.
+ * If the Formula has a Proof all added and deleted Clauses are written
+ * to it.
+ * The Formula must not have learned Clauses and satisfying assignments
+ * of the simplified Formula only satisfy the original one after
+ * ReconstructionStack_extend_model, so assumptions and counting models
+ * are not supported.
+**/
+void Preprocessor_run(Formula* formula, ReconstructionStack* stack);
+
+
+#endif
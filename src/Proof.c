@@ -0,0 +1,156 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+
+
+#include "Proof.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+// Size of the buffer collecting the proof before it is written
+#define PROOF_BUFFER_SIZE (1 << 20)
+
+// Room needed for writing one Literal in either format
+#define PROOF_LITERAL_SIZE 16
+
+
+static void Proof_flush(Proof* proof) {
+    if (proof->buffer_c > 0 && !proof->failed &&
+        fwrite(proof->buffer_v, 1, proof->buffer_c, proof->file) != proof->buffer_c) {
+        fprintf(stderr, "Error - could not write proof: %s\n", strerror(errno));
+        proof->failed = true;
+    }
+    proof->buffer_c = 0;
+}
+
+static inline void Proof_reserve(Proof* proof) {
+    if (PROOF_BUFFER_SIZE - proof->buffer_c < PROOF_LITERAL_SIZE) {
+        Proof_flush(proof);
+    }
+}
+
+static void Proof_write_literal(Proof* proof, Literal literal) {
+    Proof_reserve(proof);
+    char* out = proof->buffer_v + proof->buffer_c;
+
+    if (proof->binary) {
+        // 2 * DIMACS Variable + negated in groups of 7 bits, the lowest
+        // group first and every group but the last with the 8th bit set
+        unsigned int value = literal + 2;
+        while (value > 127) {
+            *out++ = (char)(128 | (value & 127));
+            value >>= 7;
+        }
+        *out++ = (char)value;
+    } else {
+        if (Literal_is_negated(literal)) {
+            *out++ = '-';
+        }
+
+        // Write digits backwards into a small buffer first
+        char digits[12];
+        unsigned int digits_c = 0;
+        unsigned int value = Literal_get_variable(literal) + 1;
+        do {
+            digits[digits_c++] = (char)('0' + value % 10);
+            value /= 10;
+        } while (value > 0);
+
+        while (digits_c > 0) {
+            *out++ = digits[--digits_c];
+        }
+        *out++ = ' ';
+    }
+
+    proof->buffer_c = out - proof->buffer_v;
+}
+
+static void Proof_write_clause(Proof* proof, char prefix, const Literal* literals_v, unsigned int literals_c) {
+    Proof_reserve(proof);
+    if (proof->binary) {
+        proof->buffer_v[proof->buffer_c++] = prefix;
+    } else if (prefix == 'd') {
+        proof->buffer_v[proof->buffer_c++] = 'd';
+        proof->buffer_v[proof->buffer_c++] = ' ';
+    }
+
+    for (unsigned int i = 0; i < literals_c; i++) {
+        Proof_write_literal(proof, literals_v[i]);
+    }
+
+    Proof_reserve(proof);
+    if (proof->binary) {
+        proof->buffer_v[proof->buffer_c++] = 0;
+    } else {
+        proof->buffer_v[proof->buffer_c++] = '0';
+        proof->buffer_v[proof->buffer_c++] = '\n';
+    }
+}
+
+Proof* Proof_open(const char* path, bool binary) {
+    assert(path != NULL);
+
+    FILE* file = fopen(path, binary ? "wb" : "w");
+    if (file == NULL) {
+        fprintf(stderr, "Error - could not create '%s': %s\n", path, strerror(errno));
+        return NULL;
+    }
+
+    Proof* proof = malloc(sizeof(Proof));
+    assert(proof != NULL);
+    proof->file = file;
+    proof->binary = binary;
+    proof->buffer_v = malloc(PROOF_BUFFER_SIZE);
+    assert(proof->buffer_v != NULL);
+    proof->buffer_c = 0;
+    proof->failed = false;
+
+    return proof;
+}
+
+bool Proof_close(Proof* proof) {
+    assert(proof != NULL);
+
+    Proof_flush(proof);
+    if (fclose(proof->file) != 0 && !proof->failed) {
+        fprintf(stderr, "Error - could not write proof: %s\n", strerror(errno));
+        proof->failed = true;
+    }
+
+    bool success = !proof->failed;
+    free(proof->buffer_v);
+    free(proof);
+
+    return success;
+}
+
+void Proof_add(Proof* proof, const Literal* literals_v, unsigned int literals_c) {
+    assert(proof != NULL);
+    assert(literals_v != NULL || literals_c == 0);
+
+    Proof_write_clause(proof, 'a', literals_v, literals_c);
+}
+
+void Proof_delete(Proof* proof, const Literal* literals_v, unsigned int literals_c) {
+    assert(proof != NULL);
+    assert(literals_v != NULL);
+
+    Proof_write_clause(proof, 'd', literals_v, literals_c);
+}
@@ -0,0 +1,80 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+
+
+#ifndef PROOF_H
+#define PROOF_H
+
+
+#include "Literal.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+
+/**
+ * Writes a DRAT proof, the sequence of Clauses a solver added and deleted
+ * while showing that a Formula is unsatisfiable, which ends with the
+ * empty Clause. Every added Clause follows from the Formula and the
+ * Clauses added before by unit propagation, so that independent tools
+ * can check the result.
+ *
+ * Variables are written as in DIMACS, Variable 0 being 1. Output goes
+ * through a large buffer so that writing the proof barely slows down the
+ * search.
+**/
+typedef struct {
+    FILE* file;
+
+    // Whether the compact binary format is written instead of text
+    bool binary;
+
+    char* buffer_v;
+    size_t buffer_c;
+
+    // Whether writing to the file failed
+    bool failed;
+} Proof;
+
+
+/**
+ * Creates the file at the given path for writing a proof.
+ *
+ * Returns NULL if the file can't be created.
+**/
+Proof* Proof_open(const char* path, bool binary);
+
+/**
+ * Writes the rest of the proof and destroys it.
+ *
+ * Returns false if writing the proof failed.
+**/
+bool Proof_close(Proof* proof);
+
+/**
+ * Writes the addition of a Clause.
+**/
+void Proof_add(Proof* proof, const Literal* literals_v, unsigned int literals_c);
+
+/**
+ * Writes the deletion of a Clause.
+**/
+void Proof_delete(Proof* proof, const Literal* literals_v, unsigned int literals_c);
+
+
+#endif
@@ -0,0 +1,96 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+
+
+#include "ReconstructionStack.h"
+
+#include <assert.h>
+#include <stdlib.h>
+
+
+ReconstructionStack* ReconstructionStack_create(void) {
+    ReconstructionStack* stack = malloc(sizeof(ReconstructionStack));
+    assert(stack != NULL);
+
+    stack->capacity = 64;
+    stack->entries_v = malloc(stack->capacity * sizeof(unsigned int));
+    assert(stack->entries_v != NULL);
+    stack->entries_c = 0;
+
+    return stack;
+}
+
+void ReconstructionStack_destroy(ReconstructionStack* stack) {
+    assert(stack != NULL);
+
+    free(stack->entries_v);
+    free(stack);
+}
+
+static void ReconstructionStack_append(ReconstructionStack* stack, unsigned int entry) {
+    if (stack->entries_c == stack->capacity) {
+        stack->capacity *= 2;
+        stack->entries_v = realloc(stack->entries_v, stack->capacity * sizeof(unsigned int));
+        assert(stack->entries_v != NULL);
+    }
+
+    stack->entries_v[stack->entries_c++] = entry;
+}
+
+void ReconstructionStack_push(ReconstructionStack* stack, Literal eliminated, const Literal* literals_v,
+                              unsigned int literals_c) {
+    assert(stack != NULL);
+    assert(literals_v != NULL || literals_c == 0);
+
+    ReconstructionStack_append(stack, eliminated);
+    for (unsigned int i = 0; i < literals_c; i++) {
+        if (literals_v[i] != eliminated) {
+            ReconstructionStack_append(stack, literals_v[i]);
+        }
+    }
+    ReconstructionStack_append(stack, literals_c);
+}
+
+void ReconstructionStack_extend_model(ReconstructionStack* stack, Formula* formula) {
+    assert(stack != NULL);
+    assert(formula != NULL);
+
+    for (Variable variable = 0; variable < formula->variables_c; variable++) {
+        if (formula->assignments_v[variable] == LiteralAssignment_UNSET) {
+            formula->assignments_v[variable] = LiteralAssignment_FALSE;
+        }
+    }
+
+    unsigned int end = stack->entries_c;
+    while (end > 0) {
+        unsigned int literals_c = stack->entries_v[end - 1];
+        unsigned int start = end - 1 - literals_c;
+
+        bool satisfied = false;
+        for (unsigned int i = start + 1; i < end - 1 && !satisfied; i++) {
+            satisfied = Formula_get_assignment(formula, stack->entries_v[i]) == LiteralAssignment_TRUE;
+        }
+
+        if (!satisfied) {
+            Literal eliminated = stack->entries_v[start];
+            formula->assignments_v[Literal_get_variable(eliminated)] =
+                Literal_is_negated(eliminated) ? LiteralAssignment_FALSE : LiteralAssignment_TRUE;
+        }
+
+        end = start;
+    }
+}
@@ -0,0 +1,71 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+
+
+#ifndef RECONSTRUCTIONSTACK_H
+#define RECONSTRUCTIONSTACK_H
+
+
+#include "Formula.h"
+
+
+/**
+ * Clauses removed by eliminating Variables, which are needed to extend a
+ * model of the remaining Clauses to the eliminated Variables.
+ *
+ * Every removed Clause is stored as its Literals followed by their number,
+ * the first Literal belongs to the eliminated Variable.
+**/
+typedef struct {
+    unsigned int* entries_v;
+    unsigned int entries_c;
+    unsigned int capacity;
+} ReconstructionStack;
+
+
+/**
+ * Creates a new empty ReconstructionStack.
+**/
+ReconstructionStack* ReconstructionStack_create(void);
+
+/**
+ * Destroys a ReconstructionStack.
+**/
+void ReconstructionStack_destroy(ReconstructionStack* stack);
+
+/**
+ * Pushes a Clause that was removed for eliminating the Variable of the
+ * given Literal, which must be contained in the Clause.
+**/
+void ReconstructionStack_push(ReconstructionStack* stack, Literal eliminated, const Literal* literals_v,
+                              unsigned int literals_c);
+
+/**
+ * Assigns the eliminated Variables of a Formula whose remaining Clauses
+ * are satisfied by its current assignment, so that all removed Clauses
+ * are satisfied as well.
+ *
+ * Variables that are still unassigned are made false first, as the
+ * removed Clauses have to be checked against a complete assignment. Then
+ * the Clauses are visited in reverse order and whenever none of the
+ * other Literals of a Clause are true, the Literal of its eliminated
+ * Variable is made true.
+**/
+void ReconstructionStack_extend_model(ReconstructionStack* stack, Formula* formula);
+
+
+#endif
@@ -0,0 +1,124 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+#include "SplitQueue.h"
+
+#include <assert.h>
+#include <string.h>
+
+
+SplitQueue* SplitQueue_create(unsigned int threads_c) {
+    assert(threads_c > 0);
+
+    SplitQueue* queue = malloc(sizeof(SplitQueue));
+    assert(queue != NULL);
+
+    pthread_mutex_init(&queue->lock, NULL);
+    pthread_cond_init(&queue->changed, NULL);
+
+    queue->jobs_capacity = threads_c;
+    queue->jobs_v = malloc(queue->jobs_capacity * sizeof(SplitJob));
+    assert(queue->jobs_v != NULL);
+    atomic_init(&queue->jobs_c, 0);
+    atomic_init(&queue->waiting_c, 0);
+
+    queue->threads_c = threads_c;
+    queue->finished = false;
+
+    return queue;
+}
+
+void SplitQueue_destroy(SplitQueue* queue) {
+    assert(queue != NULL);
+
+    unsigned int jobs_c = atomic_load(&queue->jobs_c);
+    for (unsigned int i = 0; i < jobs_c; i++) {
+        free(queue->jobs_v[i].literals_v);
+    }
+    free(queue->jobs_v);
+
+    pthread_cond_destroy(&queue->changed);
+    pthread_mutex_destroy(&queue->lock);
+    free(queue);
+}
+
+void SplitQueue_push(SplitQueue* queue, const Literal* literals_v, unsigned int literals_c) {
+    assert(queue != NULL);
+    assert(literals_v != NULL || literals_c == 0);
+
+    SplitJob job;
+    job.literals_c = literals_c;
+    job.literals_v = NULL;
+    if (literals_c > 0) {
+        job.literals_v = malloc(literals_c * sizeof(Literal));
+        assert(job.literals_v != NULL);
+        memcpy(job.literals_v, literals_v, literals_c * sizeof(Literal));
+    }
+
+    pthread_mutex_lock(&queue->lock);
+
+    unsigned int jobs_c = atomic_load_explicit(&queue->jobs_c, memory_order_relaxed);
+    if (jobs_c == queue->jobs_capacity) {
+        queue->jobs_capacity *= 2;
+        queue->jobs_v = realloc(queue->jobs_v, queue->jobs_capacity * sizeof(SplitJob));
+        assert(queue->jobs_v != NULL);
+    }
+    queue->jobs_v[jobs_c] = job;
+    atomic_store_explicit(&queue->jobs_c, jobs_c + 1, memory_order_relaxed);
+
+    pthread_cond_signal(&queue->changed);
+    pthread_mutex_unlock(&queue->lock);
+}
+
+bool SplitQueue_pop(SplitQueue* queue, SplitJob* job) {
+    assert(queue != NULL);
+    assert(job != NULL);
+
+    pthread_mutex_lock(&queue->lock);
+    atomic_fetch_add_explicit(&queue->waiting_c, 1, memory_order_relaxed);
+
+    while (!queue->finished && atomic_load_explicit(&queue->jobs_c, memory_order_relaxed) == 0) {
+        // Nobody is searching anymore, so no more subtrees can come
+        if (atomic_load_explicit(&queue->waiting_c, memory_order_relaxed) == queue->threads_c) {
+            queue->finished = true;
+            pthread_cond_broadcast(&queue->changed);
+            break;
+        }
+
+        pthread_cond_wait(&queue->changed, &queue->lock);
+    }
+
+    bool found = false;
+    if (!queue->finished) {
+        unsigned int jobs_c = atomic_load_explicit(&queue->jobs_c, memory_order_relaxed) - 1;
+        *job = queue->jobs_v[jobs_c];
+        atomic_store_explicit(&queue->jobs_c, jobs_c, memory_order_relaxed);
+        atomic_fetch_sub_explicit(&queue->waiting_c, 1, memory_order_relaxed);
+        found = true;
+    }
+
+    pthread_mutex_unlock(&queue->lock);
+    return found;
+}
+
+void SplitQueue_finish(SplitQueue* queue) {
+    assert(queue != NULL);
+
+    pthread_mutex_lock(&queue->lock);
+    queue->finished = true;
+    pthread_cond_broadcast(&queue->changed);
+    pthread_mutex_unlock(&queue->lock);
+}
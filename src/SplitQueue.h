@@ -0,0 +1,105 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+#ifndef SPLITQUEUE_H
+#define SPLITQUEUE_H
+
+
+#include "Literal.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+
+
+/**
+ * A subtree of a search given away by one thread to be searched by
+ * another one.
+ *
+ * The subtree consists of all assignments below the given Literals, the
+ * whole search tree has no Literals (and literals_v is NULL).
+**/
+typedef struct {
+    Literal* literals_v;
+    unsigned int literals_c;
+} SplitJob;
+
+/**
+ * Queue of subtrees shared by a fixed number of threads searching the
+ * same Formula.
+ *
+ * Threads that run out of work wait for new subtrees. Searching threads
+ * give away subtrees whenever more threads are waiting than there are
+ * subtrees queued. Once all threads are waiting the whole search space
+ * has been covered.
+**/
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+
+    SplitJob* jobs_v;
+    unsigned int jobs_capacity;
+
+    // Written while holding the lock, but also read without it to decide
+    // whether to split
+    atomic_uint jobs_c;
+    atomic_uint waiting_c;
+
+    unsigned int threads_c;
+    bool finished;
+} SplitQueue;
+
+
+/**
+ * Creates a new SplitQueue for threads_c threads.
+**/
+SplitQueue* SplitQueue_create(unsigned int threads_c);
+
+/**
+ * Destroys a SplitQueue and all subtrees left in it.
+**/
+void SplitQueue_destroy(SplitQueue* queue);
+
+/**
+ * Adds the subtree below the given Literals to the queue.
+**/
+void SplitQueue_push(SplitQueue* queue, const Literal* literals_v, unsigned int literals_c);
+
+/**
+ * Waits for a subtree to search.
+ *
+ * Returns false if there is nothing left to do, either because all
+ * threads ran out of work or the search was finished.
+ * The Literals of the job have to be freed by the caller.
+**/
+bool SplitQueue_pop(SplitQueue* queue, SplitJob* job);
+
+/**
+ * Finishes the search, all waiting threads return.
+**/
+void SplitQueue_finish(SplitQueue* queue);
+
+/**
+ * Returns whether threads are waiting for more subtrees than there are
+ * queued.
+**/
+static inline bool SplitQueue_is_hungry(SplitQueue* queue) {
+    return atomic_load_explicit(&queue->waiting_c, memory_order_relaxed) >
+           atomic_load_explicit(&queue->jobs_c, memory_order_relaxed);
+}
+
+
+#endif
@@ -0,0 +1,131 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+#include "SplitSearch.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/**
+ * State shared by all threads.
+**/
+typedef struct {
+    Formula* formula;
+    SplitQueue* queue;
+
+    // Set by the first thread that satisfies the Formula
+    atomic_bool stop;
+    atomic_int winner;
+} SplitSearch;
+
+/**
+ * A single thread searching subtrees.
+**/
+typedef struct {
+    SplitSearch* search;
+    unsigned int id;
+
+    pthread_t thread;
+    Formula* copy;
+} SplitSearchWorker;
+
+
+static void* SplitSearch_run_worker(void* data) {
+    SplitSearchWorker* worker = data;
+    SplitSearch* search = worker->search;
+
+    worker->copy = Formula_copy(search->formula);
+    worker->copy->stop = &search->stop;
+    worker->copy->split_queue = search->queue;
+
+    // Refuted subtrees don't need to be explained
+    worker->copy->collect_failed = false;
+
+    SplitJob job;
+    while (SplitQueue_pop(search->queue, &job)) {
+        Formula_set_assumptions(worker->copy, job.literals_v, job.literals_c);
+        FormulaStatus result = Formula_dpll(worker->copy);
+        free(job.literals_v);
+
+        if (result == FormulaStatus_TRUE) {
+            // Stop all other threads if we are the first to satisfy the
+            // Formula
+            int expected = -1;
+            if (atomic_compare_exchange_strong(&search->winner, &expected, (int)worker->id)) {
+                atomic_store(&search->stop, true);
+                SplitQueue_finish(search->queue);
+            }
+            break;
+        }
+        if (result == FormulaStatus_UNDECIDED) {
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+FormulaStatus SplitSearch_solve(Formula* formula, unsigned int threads_c) {
+    assert(formula != NULL);
+    assert(threads_c > 0);
+
+    SplitSearch search;
+    search.formula = formula;
+    search.queue = SplitQueue_create(threads_c);
+    atomic_init(&search.stop, false);
+    atomic_init(&search.winner, -1);
+
+    // The first thread to start takes the whole search tree
+    if (!formula->inconsistent) {
+        SplitQueue_push(search.queue, NULL, 0);
+    }
+
+    SplitSearchWorker* workers_v = malloc(threads_c * sizeof(SplitSearchWorker));
+    assert(workers_v != NULL);
+    for (unsigned int i = 0; i < threads_c; i++) {
+        workers_v[i].search = &search;
+        workers_v[i].id = i;
+        workers_v[i].copy = NULL;
+
+        int error = pthread_create(&workers_v[i].thread, NULL, SplitSearch_run_worker, &workers_v[i]);
+        assert(error == 0);
+        (void)error;
+    }
+    for (unsigned int i = 0; i < threads_c; i++) {
+        pthread_join(workers_v[i].thread, NULL);
+    }
+
+    // Formula is unsatisfiable if all subtrees were refuted
+    FormulaStatus result = FormulaStatus_FALSE;
+    int winner = atomic_load(&search.winner);
+    if (winner >= 0) {
+        result = FormulaStatus_TRUE;
+        memcpy(formula->assignments_v,
+               workers_v[winner].copy->assignments_v,
+               formula->variables_c * sizeof(LiteralAssignment));
+    }
+
+    for (unsigned int i = 0; i < threads_c; i++) {
+        Formula_destroy(workers_v[i].copy);
+    }
+    free(workers_v);
+    SplitQueue_destroy(search.queue);
+
+    return result;
+}
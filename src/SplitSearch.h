@@ -0,0 +1,40 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+#ifndef SPLITSEARCH_H
+#define SPLITSEARCH_H
+
+
+#include "Formula.h"
+
+
+/**
+ * Decides whether a Formula is satisfiable by running Formula_dpll on
+ * threads_c threads that divide the search tree among each other while
+ * searching.
+ *
+ * Every thread works on its own copy of the Formula. The first thread
+ * starts with the whole search tree. Whenever threads are idle, searching
+ * threads give away the untried branch of their earliest decision
+ * through a shared SplitQueue. The Formula is unsatisfiable once all
+ * threads are idle, the first satisfying assignment stops all threads.
+ * If the Formula is satisfiable the satisfying assignment is stored in
+ * the given Formula.
+**/
+FormulaStatus SplitSearch_solve(Formula* formula, unsigned int threads_c);
+
+
+#endif
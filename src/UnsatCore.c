@@ -0,0 +1,169 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+
+
+#include "UnsatCore.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/**
+ * Creates a Formula with the Clauses of the given Formula at the given
+ * indices, the k-th of them extended by the negated selector Variable
+ * variables_c + k.
+**/
+static Formula* UnsatCore_create_selector_formula(Formula* formula, const unsigned int* indices_v, unsigned int indices_c) {
+    unsigned int variables_c = formula->variables_c + indices_c;
+
+    ClauseArena* arena = ClauseArena_create(formula->arena->size + indices_c);
+    ClauseRefVector* clauses = ClauseRefVector_create(indices_c);
+    Literal* literals_v = malloc((formula->variables_c + 1) * sizeof(Literal));
+    assert(literals_v != NULL);
+
+    for (unsigned int k = 0; k < indices_c; k++) {
+        Clause* clause = ClauseArena_get(formula->arena, formula->clauses->data[indices_v[k]]);
+        memcpy(literals_v, clause->literals_v, clause->literals_c * sizeof(Literal));
+        literals_v[clause->literals_c] = Literal_create(formula->variables_c + k, true);
+
+        ClauseRefVector_append(clauses, ClauseArena_add(arena, literals_v, clause->literals_c + 1, false));
+    }
+    free(literals_v);
+
+    char** names_v = malloc(variables_c * sizeof(char*));
+    assert(names_v != NULL);
+    for (unsigned int v = 0; v < formula->variables_c; v++) {
+        names_v[v] = strdup(formula->names_v[v]);
+        assert(names_v[v] != NULL);
+    }
+    for (unsigned int k = 0; k < indices_c; k++) {
+        char name[16];
+        snprintf(name, sizeof(name), "s%u", k + 1);
+        names_v[formula->variables_c + k] = strdup(name);
+        assert(names_v[formula->variables_c + k] != NULL);
+    }
+
+    Formula* selector_formula = Formula_create(arena, clauses, names_v, variables_c);
+    selector_formula->decision_heuristic = formula->decision_heuristic;
+    selector_formula->decision_phase = formula->decision_phase;
+
+    return selector_formula;
+}
+
+unsigned int* UnsatCore_collect(Formula* formula, unsigned int* indices_c) {
+    assert(formula != NULL);
+    assert(indices_c != NULL);
+
+    unsigned int* indices_v = malloc(formula->clauses->size * sizeof(unsigned int));
+    assert(indices_v != NULL || formula->clauses->size == 0);
+
+    *indices_c = 0;
+    for (unsigned int i = 0; i < formula->clauses->size; i++) {
+        if (ClauseArena_get(formula->arena, formula->clauses->data[i])->core) {
+            indices_v[(*indices_c)++] = i;
+        }
+    }
+
+    return indices_v;
+}
+
+void UnsatCore_minimize(Formula* formula, FormulaEngine engine, unsigned int* indices_v, unsigned int* indices_c) {
+    assert(formula != NULL);
+    assert(engine != NULL);
+    assert(indices_v != NULL);
+    assert(indices_c != NULL);
+
+    unsigned int variables_c = formula->variables_c;
+    unsigned int selectors_c = *indices_c;
+    Formula* selector_formula = UnsatCore_create_selector_formula(formula, indices_v, selectors_c);
+
+    // Selectors of Clauses that are still candidates
+    unsigned int* candidates_v = malloc(selectors_c * sizeof(unsigned int));
+    bool* failed_v = calloc(selectors_c, sizeof(bool));
+    Literal* assumptions_v = malloc(selectors_c * sizeof(Literal));
+    assert(candidates_v != NULL || selectors_c == 0);
+    assert(failed_v != NULL || selectors_c == 0);
+    assert(assumptions_v != NULL || selectors_c == 0);
+    unsigned int candidates_c = selectors_c;
+    for (unsigned int k = 0; k < selectors_c; k++) {
+        candidates_v[k] = k;
+    }
+
+    // All candidates before position i are needed. Their selectors and
+    // those of left out Clauses are fixed by One-Literal-Clauses, so that
+    // only the others are assumed.
+    unsigned int i = 0;
+    while (i < candidates_c) {
+        unsigned int assumptions_c = 0;
+        assumptions_v[assumptions_c++] = Literal_create(variables_c + candidates_v[i], true);
+        for (unsigned int c = i + 1; c < candidates_c; c++) {
+            assumptions_v[assumptions_c++] = Literal_create(variables_c + candidates_v[c], false);
+        }
+
+        Formula_set_assumptions(selector_formula, assumptions_v, assumptions_c);
+        FormulaStatus result = engine(selector_formula);
+
+        if (result == FormulaStatus_TRUE) {
+            // Without this Clause the rest is satisfiable
+            Literal selector = Literal_create(variables_c + candidates_v[i], false);
+            Formula_add_clause(selector_formula, &selector, 1);
+            i++;
+            continue;
+        }
+        if (result != FormulaStatus_FALSE) {
+            break;
+        }
+
+        // Leave out the Clause along with all later candidates that were
+        // not needed for the conflict
+        for (unsigned int f = 0; f < selector_formula->failed_c; f++) {
+            Literal failed = selector_formula->failed_v[f];
+            if (!Literal_is_negated(failed)) {
+                failed_v[Literal_get_variable(failed) - variables_c] = true;
+            }
+        }
+
+        unsigned int kept_c = i;
+        for (unsigned int c = i; c < candidates_c; c++) {
+            if (failed_v[candidates_v[c]]) {
+                candidates_v[kept_c++] = candidates_v[c];
+            } else {
+                Literal selector = Literal_create(variables_c + candidates_v[c], true);
+                Formula_add_clause(selector_formula, &selector, 1);
+            }
+        }
+        candidates_c = kept_c;
+
+        for (unsigned int f = 0; f < selector_formula->failed_c; f++) {
+            failed_v[Literal_get_variable(selector_formula->failed_v[f]) - variables_c] = false;
+        }
+    }
+
+    // Map selectors back to Clauses of the Formula
+    for (unsigned int c = 0; c < candidates_c; c++) {
+        candidates_v[c] = indices_v[candidates_v[c]];
+    }
+    memcpy(indices_v, candidates_v, candidates_c * sizeof(unsigned int));
+    *indices_c = candidates_c;
+
+    free(candidates_v);
+    free(failed_v);
+    free(assumptions_v);
+    Formula_destroy(selector_formula);
+}
@@ -0,0 +1,52 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+
+
+#ifndef UNSATCORE_H
+#define UNSATCORE_H
+
+
+#include "Formula.h"
+
+
+/**
+ * Returns the indices of the Clauses of a Formula that were marked as
+ * part of the unsatisfiable core, which are their positions in the input
+ * counted from 0, in ascending order. The result has to be freed.
+ *
+ * The Formula has to be found unsatisfiable by a search that collected
+ * the core, the marked Clauses are unsatisfiable on their own then.
+**/
+unsigned int* UnsatCore_collect(Formula* formula, unsigned int* indices_c);
+
+/**
+ * Leaves out Clauses of an unsatisfiable core one at a time as long as
+ * the rest stays unsatisfiable, so that none of the remaining Clauses can
+ * be left out.
+ *
+ * Every Clause of the core gets a selector Variable that switches it off
+ * when false, so that all candidates are checked by searching the same
+ * copy of the Formula under different assumptions with the given engine,
+ * which keeps learned Clauses. If a search is unsatisfiable all
+ * candidates whose selectors are not among the failed assumptions are
+ * left out at once.
+ * The indices are replaced by the remaining ones.
+**/
+void UnsatCore_minimize(Formula* formula, FormulaEngine engine, unsigned int* indices_v, unsigned int* indices_c);
+
+
+#endif
@@ -0,0 +1,53 @@
+#!/bin/bash
+
+set -e
+
+if [[ $# -lt 1 ]]; then
+    echo "Error: Expected at least one argument but got $#" > /dev/stderr
+    exit 1
+fi
+
+TARGET="$1"
+OPTIONS=("${@:2}")
+
+if [[ ! -f "$TARGET" ]] || [[ ! -x "$TARGET" ]]; then
+    echo "Error: Could not find target at '$TARGET'" > /dev/stderr
+    exit 1
+fi
+
+# 1 implies 2 implies 3 implies not 4
+FORMULA="p cnf 4 3
+-1 2 0
+-2 3 0
+-3 -4 0"
+
+echo "Solving under assumptions with \"$TARGET\"..."
+OUTPUT="$(echo "$FORMULA" | "$TARGET" --dimacs "${OPTIONS[@]}" \
+    --assume 1,4 --assume 1 --assume 4,-2,1 --assume 2,-2)"
+echo "$OUTPUT"
+
+# Prints line $1 of the output, failed assumptions are sorted as their
+# order is not specified
+line() {
+    LINE="$(echo "$OUTPUT" | sed -n "$1p")"
+    if [[ "$LINE" == "Failed assumptions:"* ]]; then
+        echo "Failed assumptions:" $(echo "${LINE#*:}" | tr ' ' '\n' | sort)
+    else
+        echo "$LINE"
+    fi
+}
+
+# Both assumptions are needed for the first query, the third one is
+# unsatisfiable without -2 and the last one only by its assumptions
+if [[ "$(echo "$OUTPUT" | wc -l)" -ne 7 ]] ||
+   [[ "$(line 1)" != "Formula is not satisfiable" ]] ||
+   [[ "$(line 2)" != "Failed assumptions: 1 4" ]] ||
+   [[ "$(line 3)" != "1=true 2=true 3=true 4=false " ]] ||
+   [[ "$(line 4)" != "Formula is not satisfiable" ]] ||
+   [[ "$(line 5)" != "Failed assumptions: 1 4" ]] ||
+   [[ "$(line 6)" != "Formula is not satisfiable" ]] ||
+   [[ "$(line 7)" != "Failed assumptions: -2 2" ]]; then
+    echo "Error: Unexpected output" > /dev/stderr
+    exit 1
+fi
+exit 0
@@ -0,0 +1,40 @@
+#!/bin/bash
+
+set -e
+
+if [[ $# -lt 3 ]]; then
+    echo "Error: Expected at least three arguments but got $#" > /dev/stderr
+    exit 1
+fi
+
+TARGET="$1"
+DIRECTORY="$2"
+EXPECTED="$3"
+OPTIONS=("${@:4}")
+
+if [[ ! -f "$TARGET" ]] || [[ ! -x "$TARGET" ]]; then
+    echo "Error: Could not find target at '$TARGET'" > /dev/stderr
+    exit 1
+fi
+
+if [[ ! -d "$DIRECTORY" ]]; then
+    echo "Error: Could not find directory at '$DIRECTORY'" > /dev/stderr
+    exit 1
+fi
+
+echo "Solving all files in \"$DIRECTORY\" with \"$TARGET\"..."
+echo "All formulas are expected to be $EXPECTED."
+
+OUTPUT="$("$TARGET" --dimacs --batch "${OPTIONS[@]}" "$DIRECTORY")"
+echo "$OUTPUT"
+
+# Every file has to be reported exactly once with the expected result
+FILES="$(find "$DIRECTORY" -maxdepth 1 -type f -not -name '.*' | wc -l)"
+REPORTED="$(echo "$OUTPUT" | cut -f 1 | sort -u | wc -l)"
+MATCHING="$(echo "$OUTPUT" | cut -f 2 | grep -cx "$EXPECTED" || true)"
+
+if [[ "$REPORTED" -ne "$FILES" ]] || [[ "$MATCHING" -ne "$FILES" ]]; then
+    echo "Error: Expected $FILES files to be $EXPECTED but got $MATCHING of $REPORTED" > /dev/stderr
+    exit 1
+fi
+exit 0
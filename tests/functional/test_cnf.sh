@@ -0,0 +1,29 @@
+#!/bin/bash
+
+set -e
+
+source "$(dirname "${BASH_SOURCE[0]}")/../helper/expect.sh"
+
+FORMAT="--cnf"
+
+echo "Parsing plain text formulas with \"$TARGET\"..."
+
+# Default syntax, Variables are numbered in order of their first
+# appearance
+expect "$(solve "{A, B}, {-A}, {-B, C}" | sed 's/ *$//')" "A=false B=true C=true"
+expect "$(solve "{Long_name1, b}, {-Long_name1}, {-b}")" "Formula is not satisfiable"
+
+# Custom syntax
+expect "$(solve "(A v B) ^ (~A) ^ (~B v C)" --cstart '(' --cend ')' --cdel 'v' --cneg '~' | sed 's/ *$//')" \
+    "A=false B=true C=true"
+
+# Empty Literals are skipped instead of creating a Variable without name
+expect "$(solve "{A, , B}, {-A}" | sed 's/ *$//')" "A=false B=true"
+expect "$(solve "{, A,}, {}" | sed 's/ *$//')" "Formula is not satisfiable"
+
+# A Clause that is not closed ends with the input
+expect "$(solve "{A}, {-A, B" | sed 's/ *$//')" "A=true B=true"
+
+# Repeated names refer to the same Variable and negations cancel out
+expect "$(solve "{A, B}, {-A, B}, {A, -B}, {--A}" | sed 's/ *$//')" "A=true B=true"
+exit 0
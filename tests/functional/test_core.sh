@@ -0,0 +1,44 @@
+#!/bin/bash
+
+set -e
+
+source "$(dirname "${BASH_SOURCE[0]}")/../helper/expect.sh"
+
+echo "Finding unsatisfiable cores with \"$TARGET\"..."
+
+# Only clauses 1, 2 and 4 are needed, which are numbered from 1 like in the
+# input
+FORMULA="p cnf 4 6
+1 2 0
+-1 0
+3 4 0
+-2 0
+-3 -4 0
+2 3 0"
+expect "$(solve "$FORMULA" --core)" "Formula is not satisfiable
+Unsatisfiable core: 1 2 4"
+expect "$(solve "$FORMULA" --mus)" "Formula is not satisfiable
+Minimal unsatisfiable core: 1 2 4"
+
+# Conflicts are only found after decisions, clauses 1, 4 and 8 are not
+# needed
+FORMULA="p cnf 7 8
+5 6 0
+4 -2 0
+-1 2 4 0
+-5 -6 0
+1 0
+3 -4 0
+-1 -3 -4 0
+6 7 0"
+expect "$(solve "$FORMULA" --core)" "Formula is not satisfiable
+Unsatisfiable core: 2 3 5 6 7"
+expect "$(solve "$FORMULA" --mus)" "Formula is not satisfiable
+Minimal unsatisfiable core: 2 3 5 6 7"
+
+# Satisfiable formulas have no core
+FORMULA="p cnf 2 2
+1 2 0
+-1 0"
+expect "$(solve "$FORMULA" --mus | sed 's/ *$//')" "1=false 2=true"
+exit 0
@@ -0,0 +1,46 @@
+#!/bin/bash
+
+set -e
+
+source "$(dirname "${BASH_SOURCE[0]}")/../helper/expect.sh"
+
+# Every formula is counted with the components engine
+OPTIONS=("--engine=components" "--count" "${OPTIONS[@]}")
+
+echo "Counting models with \"$TARGET\"..."
+
+FORMULA="p cnf 4 2
+1 2 0
+-3 4 0"
+expect "$(solve "$FORMULA")" "Number of models: 9"
+expect "$(solve "$FORMULA" --assume -1,-4)" "Number of models: 1"
+
+# Counts exceed 64 bits
+FORMULA="p cnf 100 1
+$(seq 1 100 | tr '\n' ' ')0"
+expect "$(solve "$FORMULA")" "Number of models: 1267650600228229401496703205375"
+
+# 100 independent components with 3 models each, which can't be counted
+# by enumerating the models
+FORMULA="p cnf 200 100
+$(for i in $(seq 1 2 200); do echo "$i $((i + 1)) 0"; done)"
+expect "$(solve "$FORMULA")" "Number of models: 515377520732011331036461129765621272702107522001"
+
+# Components reappear after different assignments of a shared Variable
+FORMULA="p cnf 7 6
+1 2 3 0
+-1 2 3 0
+4 5 0
+-4 -5 0
+1 6 7 0
+-6 -7 0"
+expect "$(solve "$FORMULA")" "Number of models: 30"
+
+FORMULA="p cnf 2 4
+1 2 0
+-1 2 0
+1 -2 0
+-1 -2 0"
+expect "$(solve "$FORMULA")" "Formula is not satisfiable
+Number of models: 0"
+exit 0
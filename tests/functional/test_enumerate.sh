@@ -0,0 +1,27 @@
+#!/bin/bash
+
+set -e
+
+source "$(dirname "${BASH_SOURCE[0]}")/../helper/expect.sh"
+
+echo "Enumerating models with \"$TARGET\"..."
+
+FORMULA="p cnf 4 2
+1 2 0
+-3 4 0"
+expect "$(solve "$FORMULA" --count)" "Number of models: 9"
+expect "$(solve "$FORMULA" --enumerate | wc -l)" "4"
+expect "$(solve "$FORMULA" --enumerate 2 | wc -l)" "2"
+expect "$(solve "$FORMULA" --count --assume -1,-4)" "Number of models: 1"
+
+# Counts exceed 64 bits
+FORMULA="p cnf 100 1
+$(seq 1 100 | tr '\n' ' ')0"
+expect "$(solve "$FORMULA" --count)" "Number of models: 1267650600228229401496703205375"
+
+FORMULA="p cnf 1 2
+1 0
+-1 0"
+expect "$(solve "$FORMULA" --count --enumerate)" "Formula is not satisfiable
+Number of models: 0"
+exit 0
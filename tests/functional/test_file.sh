@@ -0,0 +1,52 @@
+#!/bin/bash
+
+set -e
+
+if [[ $# -lt 5 ]]; then
+    echo "Error: Expected at least five arguments but got $#" > /dev/stderr
+    exit 1
+fi
+
+TARGET="$1"
+RESOURCE="$2"
+EXPECTED="$3"
+CONVERTER="$4"
+CHECKER="$5"
+OPTIONS=("${@:6}")
+
+if [[ ! -f "$TARGET" ]] || [[ ! -x "$TARGET" ]]; then
+    echo "Error: Could not find target at '$TARGET'" > /dev/stderr
+    exit 1
+fi
+
+if [[ ! -f "$RESOURCE" ]]; then
+    echo "Error: Could not find resource at '$RESOURCE'" > /dev/stderr
+    exit 1
+fi
+
+if [[ "$EXPECTED" != "satisfiable" ]] && [[ "$EXPECTED" != "unsatisfiable" ]]; then
+    echo "Error: Expected result has to be 'satisfiable' or 'unsatisfiable' but is '$EXPECTED'" > /dev/stderr
+    exit 1
+fi
+
+if [[ ! -f "$CONVERTER" ]] || [[ ! -x "$CONVERTER" ]]; then
+    echo "Error: Could not find converter at '$CONVERTER'" > /dev/stderr
+    exit 1
+fi
+
+if [[ ! -f "$CHECKER" ]] || [[ ! -x "$CHECKER" ]]; then
+    echo "Error: Could not find checker at '$CHECKER'" > /dev/stderr
+    exit 1
+fi
+
+echo "Solving \"$RESOURCE\" given by its path with \"$TARGET\"..."
+echo "Formula is expected to be $EXPECTED."
+
+# Nothing is given on stdin, so the formula can only come from the path
+if [[ "$EXPECTED" == "unsatisfiable" ]]; then
+    "$TARGET" --dimacs "${OPTIONS[@]}" "$RESOURCE" < /dev/null | grep -x 'Formula is not satisfiable'
+    exit $?
+fi
+
+"$TARGET" --dimacs "${OPTIONS[@]}" "$RESOURCE" < /dev/null | "$CONVERTER" | "$CHECKER" --problem "$RESOURCE" -s '-'
+exit $?
@@ -0,0 +1,220 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+
+
+
+
+#include "ipasir.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+#define CHECK(condition) do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            exit(1); \
+        } \
+    } while (0)
+
+#define RANDOM_VARIABLES 12
+#define RANDOM_ROUNDS 80
+
+
+static void add_clause(void* solver, const int32_t* literals) {
+    for (; *literals != 0; literals++) {
+        ipasir_add(solver, *literals);
+    }
+    ipasir_add(solver, 0);
+}
+
+static int stop_immediately(void* data) {
+    (void)data;
+    return 1;
+}
+
+static void count_learned(void* data, int32_t* clause) {
+    (void)clause;
+    (*(unsigned int*)data)++;
+}
+
+/**
+ * Checks the basic use of the interface on a small Formula.
+**/
+static void test_basic(void) {
+    void* solver = ipasir_init();
+
+    add_clause(solver, (int32_t[]){1, 2, 0});
+    add_clause(solver, (int32_t[]){-1, 2, 0});
+    add_clause(solver, (int32_t[]){-2, 3, 0});
+
+    CHECK(ipasir_solve(solver) == 10);
+    CHECK(ipasir_val(solver, 2) == 2);
+    CHECK(ipasir_val(solver, -3) == 3);
+
+    // Assumptions only hold for a single call
+    ipasir_assume(solver, -3);
+    ipasir_assume(solver, 1);
+    CHECK(ipasir_solve(solver) == 20);
+    CHECK(ipasir_failed(solver, -3));
+    CHECK(!ipasir_failed(solver, 1));
+    CHECK(ipasir_solve(solver) == 10);
+
+    // Clauses stay, also with new Variables
+    add_clause(solver, (int32_t[]){-3, 4, 0});
+    ipasir_assume(solver, -4);
+    CHECK(ipasir_solve(solver) == 20);
+    CHECK(ipasir_failed(solver, -4));
+
+    add_clause(solver, (int32_t[]){-4, 0});
+    CHECK(ipasir_solve(solver) == 20);
+    CHECK(ipasir_solve(solver) == 20);
+
+    ipasir_release(solver);
+}
+
+/**
+ * Checks that the terminate callback interrupts the search.
+**/
+static void test_terminate(void) {
+    void* solver = ipasir_init();
+
+    // Pigeon hole principle with 6 pigeons and 5 holes
+    for (int32_t pigeon = 0; pigeon < 6; pigeon++) {
+        for (int32_t hole = 0; hole < 5; hole++) {
+            ipasir_add(solver, pigeon * 5 + hole + 1);
+        }
+        ipasir_add(solver, 0);
+    }
+    for (int32_t hole = 0; hole < 5; hole++) {
+        for (int32_t a = 0; a < 6; a++) {
+            for (int32_t b = a + 1; b < 6; b++) {
+                add_clause(solver, (int32_t[]){-(a * 5 + hole + 1), -(b * 5 + hole + 1), 0});
+            }
+        }
+    }
+
+    ipasir_set_terminate(solver, NULL, stop_immediately);
+    CHECK(ipasir_solve(solver) == 0);
+
+    unsigned int learned_c = 0;
+    ipasir_set_terminate(solver, NULL, NULL);
+    ipasir_set_learn(solver, &learned_c, 2, count_learned);
+    CHECK(ipasir_solve(solver) == 20);
+
+    ipasir_release(solver);
+}
+
+/**
+ * Solves the given Clauses under the given Assumptions by enumerating all
+ * assignments.
+**/
+static bool brute_force(int32_t clauses_v[][4], unsigned int clauses_c, const int32_t* assumptions_v, unsigned int assumptions_c) {
+    for (unsigned int assignment = 0; assignment < (1u << RANDOM_VARIABLES); assignment++) {
+        bool satisfied = true;
+
+        for (unsigned int i = 0; i < assumptions_c && satisfied; i++) {
+            int32_t lit = assumptions_v[i];
+            bool value = (assignment >> (abs(lit) - 1)) & 1;
+            satisfied = (lit > 0) == value;
+        }
+
+        for (unsigned int i = 0; i < clauses_c && satisfied; i++) {
+            satisfied = false;
+            for (unsigned int j = 0; clauses_v[i][j] != 0 && !satisfied; j++) {
+                int32_t lit = clauses_v[i][j];
+                bool value = (assignment >> (abs(lit) - 1)) & 1;
+                satisfied = (lit > 0) == value;
+            }
+        }
+
+        if (satisfied) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Adds random Clauses one after another and solves under random
+ * Assumptions after each of them, comparing to brute force.
+**/
+static void test_random(void) {
+    static int32_t clauses_v[RANDOM_ROUNDS][4];
+    srand(42);
+
+    for (unsigned int instance = 0; instance < 20; instance++) {
+        void* solver = ipasir_init();
+
+        // Solving goes on after the Formula became unsatisfiable
+        for (unsigned int round = 0; round < RANDOM_ROUNDS; round++) {
+            for (unsigned int j = 0; j < 3; j++) {
+                int32_t variable = rand() % RANDOM_VARIABLES + 1;
+                clauses_v[round][j] = (rand() % 2) ? variable : -variable;
+            }
+            clauses_v[round][3] = 0;
+            add_clause(solver, clauses_v[round]);
+
+            int32_t assumptions_v[4];
+            unsigned int assumptions_c = (unsigned int)(rand() % 5);
+            for (unsigned int j = 0; j < assumptions_c; j++) {
+                int32_t variable = rand() % RANDOM_VARIABLES + 1;
+                assumptions_v[j] = (rand() % 2) ? variable : -variable;
+                ipasir_assume(solver, assumptions_v[j]);
+            }
+
+            int result = ipasir_solve(solver);
+            CHECK(result == (brute_force(clauses_v, round + 1, assumptions_v, assumptions_c) ? 10 : 20));
+
+            if (result == 10) {
+                for (unsigned int i = 0; i <= round; i++) {
+                    bool satisfied = false;
+                    for (unsigned int j = 0; j < 3; j++) {
+                        satisfied |= ipasir_val(solver, clauses_v[i][j]) == clauses_v[i][j];
+                    }
+                    CHECK(satisfied);
+                }
+                for (unsigned int j = 0; j < assumptions_c; j++) {
+                    CHECK(ipasir_val(solver, assumptions_v[j]) == assumptions_v[j]);
+                }
+            } else {
+                // The failed Assumptions alone must make the Formula
+                // unsatisfiable
+                int32_t failed_v[4];
+                unsigned int failed_c = 0;
+                for (unsigned int j = 0; j < assumptions_c; j++) {
+                    if (ipasir_failed(solver, assumptions_v[j])) {
+                        failed_v[failed_c++] = assumptions_v[j];
+                    }
+                }
+                CHECK(!brute_force(clauses_v, round + 1, failed_v, failed_c));
+            }
+        }
+
+        ipasir_release(solver);
+    }
+}
+
+int main(void) {
+    printf("%s\n", ipasir_signature());
+
+    test_basic();
+    test_terminate();
+    test_random();
+
+    return 0;
+}
@@ -0,0 +1,43 @@
+#!/bin/bash
+
+set -e
+
+if [[ $# -lt 3 ]]; then
+    echo "Error: Expected at least three arguments but got $#" > /dev/stderr
+    exit 1
+fi
+
+TARGET="$1"
+RESOURCE="$2"
+CHECKER="$3"
+OPTIONS=("${@:4}")
+
+if [[ ! -f "$TARGET" ]] || [[ ! -x "$TARGET" ]]; then
+    echo "Error: Could not find target at '$TARGET'" > /dev/stderr
+    exit 1
+fi
+
+if [[ ! -f "$RESOURCE" ]]; then
+    echo "Error: Could not find resource at '$RESOURCE'" > /dev/stderr
+    exit 1
+fi
+
+if [[ ! -f "$CHECKER" ]] || [[ ! -x "$CHECKER" ]]; then
+    echo "Error: Could not find checker at '$CHECKER'" > /dev/stderr
+    exit 1
+fi
+
+PROOF="$(mktemp)"
+trap 'rm -f "$PROOF"' EXIT
+
+CHECKER_OPTIONS=()
+if [[ " ${OPTIONS[*]} " == *" --proof-format=binary "* ]]; then
+    CHECKER_OPTIONS+=("--binary")
+fi
+
+echo "Solving \"$RESOURCE\" with \"$TARGET\"..."
+echo "Proof of unsatisfiability will be checked with \"$CHECKER\"."
+
+"$TARGET" --dimacs --proof "$PROOF" "${OPTIONS[@]}" < "$RESOURCE" | grep -x 'Formula is not satisfiable'
+"$CHECKER" --problem "$RESOURCE" --proof "$PROOF" "${CHECKER_OPTIONS[@]}"
+exit $?
@@ -2,8 +2,8 @@
 
 set -e
 
-if [[ $# -ne 4 ]]; then
-    echo "Error: Expected exactly four arguments but got $#" > /dev/stderr
+if [[ $# -lt 4 ]]; then
+    echo "Error: Expected at least four arguments but got $#" > /dev/stderr
     exit 1
 fi
 
@@ -11,6 +11,7 @@ TARGET="$1"
 RESOURCE="$2"
 CONVERTER="$3"
 CHECKER="$4"
+OPTIONS=("${@:5}")
 
 if [[ ! -f "$TARGET" ]] || [[ ! -x "$TARGET" ]]; then
     echo "Error: Could not find target at '$TARGET'" > /dev/stderr
@@ -36,5 +37,5 @@ echo "Solving \"$RESOURCE\" with \"$TARGET\"..."
 echo "Output wil be converted to solution using \"$CONVERTER\"."
 echo "Solution will be checked for correctness with \"$CHECKER\"."
 
-"$TARGET" --dimacs < "$RESOURCE" | "$CONVERTER" | "$CHECKER" --problem "$RESOURCE" -s '-'
+"$TARGET" --dimacs "${OPTIONS[@]}" < "$RESOURCE" | "$CONVERTER" | "$CHECKER" --problem "$RESOURCE" -s '-'
 exit $?
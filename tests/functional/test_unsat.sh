@@ -0,0 +1,28 @@
+#!/bin/bash
+
+set -e
+
+if [[ $# -lt 2 ]]; then
+    echo "Error: Expected at least two arguments but got $#" > /dev/stderr
+    exit 1
+fi
+
+TARGET="$1"
+RESOURCE="$2"
+OPTIONS=("${@:3}")
+
+if [[ ! -f "$TARGET" ]] || [[ ! -x "$TARGET" ]]; then
+    echo "Error: Could not find target at '$TARGET'" > /dev/stderr
+    exit 1
+fi
+
+if [[ ! -f "$RESOURCE" ]]; then
+    echo "Error: Could not find resource at '$RESOURCE'" > /dev/stderr
+    exit 1
+fi
+
+echo "Solving \"$RESOURCE\" with \"$TARGET\"..."
+echo "Formula is expected to be unsatisfiable."
+
+"$TARGET" --dimacs "${OPTIONS[@]}" < "$RESOURCE" | grep -x 'Formula is not satisfiable'
+exit $?
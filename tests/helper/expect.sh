@@ -0,0 +1,36 @@
+#!/bin/bash
+
+# Shared part of the test scripts that compare the output of the target
+# for formulas given inline with the expected output. Has to be sourced
+# with the path of the target followed by its options as arguments.
+
+if [[ $# -lt 1 ]]; then
+    echo "Error: Expected at least one argument but got $#" > /dev/stderr
+    exit 1
+fi
+
+TARGET="$1"
+OPTIONS=("${@:2}")
+
+# Format of the formulas, scripts may change it before calling solve
+FORMAT="--dimacs"
+
+if [[ ! -f "$TARGET" ]] || [[ ! -x "$TARGET" ]]; then
+    echo "Error: Could not find target at '$TARGET'" > /dev/stderr
+    exit 1
+fi
+
+# Runs the target on the formula $1 with the remaining arguments as
+# additional options
+solve() {
+    echo "$1" | "$TARGET" "$FORMAT" "${OPTIONS[@]}" "${@:2}"
+}
+
+# Checks that $1 equals $2
+expect() {
+    echo "$1"
+    if [[ "$1" != "$2" ]]; then
+        echo "Error: Expected '$2'" > /dev/stderr
+        exit 1
+    fi
+}
@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+
+import argparse
+import sys
+
+def read_problem(path):
+    # Clauses may span several lines and a '%' ends the formula
+    tokens = []
+    with open(path, 'r') as f:
+        for line in f.readlines():
+            line = line.strip()
+            if line[:1] in ('c', 'p'):
+                continue
+            if line[:1] == '%':
+                break
+            tokens.extend(int(token) for token in line.split())
+
+    clauses = []
+    clause = []
+    for literal in tokens:
+        if literal == 0:
+            clauses.append(clause)
+            clause = []
+        else:
+            clause.append(literal)
+    return clauses
+
+def read_text_proof(data):
+    steps = []
+    clause = []
+    deletion = False
+    for token in data.decode('ascii').split():
+        if token == 'd':
+            deletion = True
+        elif int(token) == 0:
+            steps.append((deletion, clause))
+            clause = []
+            deletion = False
+        else:
+            clause.append(int(token))
+    return steps
+
+def read_binary_proof(data):
+    steps = []
+    i = 0
+    while i < len(data):
+        mark = chr(data[i])
+        assert mark in ('a', 'd')
+        i += 1
+
+        clause = []
+        while True:
+            # Literals are 2 * variable + negated in groups of 7 bits
+            value = 0
+            shift = 0
+            while data[i] & 128:
+                value |= (data[i] & 127) << shift
+                shift += 7
+                i += 1
+            value |= data[i] << shift
+            i += 1
+
+            if value == 0:
+                break
+            clause.append(-(value >> 1) if value & 1 else value >> 1)
+        steps.append((mark == 'd', clause))
+    return steps
+
+def propagates_to_conflict(clauses, assignment):
+    # Assigns Literals of clauses with only one unassigned Literal until
+    # a clause is false or nothing changes
+    changed = True
+    while changed:
+        changed = False
+        for clause in clauses:
+            unassigned = []
+            satisfied = False
+            for literal in clause:
+                if literal in assignment:
+                    satisfied = True
+                    break
+                if -literal not in assignment:
+                    unassigned.append(literal)
+
+            if satisfied:
+                continue
+            if len(unassigned) == 0:
+                return True
+            if len(unassigned) == 1:
+                assignment.add(unassigned[0])
+                changed = True
+    return False
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument(
+        '-p', '--problem',
+        help = 'Path to file in DIMACS format specifying the problem.',
+        metavar = 'PATH',
+        required = True,
+        type = str)
+    parser.add_argument(
+        '-r', '--proof',
+        help = 'Path to DRAT proof of unsatisfiability of the problem.',
+        metavar = 'PATH',
+        required = True,
+        type = str)
+    parser.add_argument(
+        '-b', '--binary',
+        help = 'Proof is in binary instead of text format.',
+        action = 'store_true')
+    args = parser.parse_args()
+
+    clauses = read_problem(args.problem)
+    with open(args.proof, 'rb') as f:
+        data = f.read()
+    steps = read_binary_proof(data) if args.binary else read_text_proof(data)
+
+    # Every added clause has to lead to a conflict by unit propagation
+    # when all its Literals are false (RUP)
+    for number, (deletion, clause) in enumerate(steps):
+        if deletion:
+            for i, other in enumerate(clauses):
+                if sorted(other) == sorted(clause):
+                    del clauses[i]
+                    break
+            else:
+                print('Deleted clause {} of step {} does not exist'.format(clause, number))
+                return 1
+            continue
+
+        if not propagates_to_conflict(clauses, set(-literal for literal in clause)):
+            print('Clause {} of step {} does not follow by unit propagation'.format(clause, number))
+            return 1
+
+        if len(clause) == 0:
+            print('Proof is correct')
+            return 0
+        clauses.append(clause)
+
+    print('Proof does not contain the empty clause')
+    return 1
+
+if __name__ == '__main__':
+    sys.exit(main())